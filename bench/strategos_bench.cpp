@@ -0,0 +1,252 @@
+// Microbenchmarks for the rules hot paths, run over a fixed corpus of
+// mid-game positions so numbers are comparable between builds.
+//
+//   strategos_bench --benchmark_format=json --benchmark_out=bench.json
+//
+// Compare two runs with Google Benchmark's tools/compare.py.
+
+#include "board.hpp"
+#include "transposition_table.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Positions reached by 10 to 40 plies of random play with captures and
+// King placements excluded, so every position is live and both sides hold
+// material on the board.
+const std::vector<Board>& corpus() {
+    static const std::vector<Board> positions = [] {
+        std::vector<Board> result;
+        std::mt19937 rng(12345);
+        for (int plies : {10, 16, 22, 28, 34, 40}) {
+            for (int variant = 0; variant < 4; ++variant) {
+                Board board;
+                board.initialize(1 + variant % 2);
+                for (int ply = 0; ply < plies;) {
+                    MoveList moves;
+                    board.generateMoves(moves);
+                    const Move move = moves[rng() % moves.size()];
+                    if (move.piece != Piece::King && !move.isCapture()) {
+                        board.applyMove(move);
+                        ++ply;
+                    }
+                }
+                // Put both Kings on the board so King moves are measured too.
+                for (int i = 0; i < PLAYER_COUNT; ++i) {
+                    MoveList moves;
+                    board.generateMoves(moves);
+                    for (const Move& move : moves) {
+                        if (move.piece == Piece::King) {
+                            board.applyMove(move);
+                            break;
+                        }
+                    }
+                }
+                result.push_back(board);
+            }
+        }
+        return result;
+    }();
+    return positions;
+}
+
+void BM_BoardCopy(benchmark::State& state) {
+    const auto& positions = corpus();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Board copy = positions[i++ % positions.size()];
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoardCopy);
+
+void BM_BoardStateCopy(benchmark::State& state) {
+    const auto& positions = corpus();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        BoardState copy = positions[i++ % positions.size()].getState();
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoardStateCopy);
+
+// Applies and undoes every placement (Arg 1) or piece move (Arg 0) of
+// every corpus position.
+void BM_ApplyUndo(benchmark::State& state) {
+    const bool placements = state.range(0) != 0;
+    std::vector<Board> boards = corpus();
+    std::vector<MoveList> moves(boards.size());
+    for (std::size_t i = 0; i < boards.size(); ++i) {
+        MoveList all;
+        boards[i].generateMoves(all);
+        for (const Move& move : all) {
+            if (move.isPlacement() == placements) {
+                moves[i].push(move);
+            }
+        }
+    }
+
+    std::int64_t applied = 0;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            for (const Move& move : moves[i]) {
+                boards[i].applyMove(move);
+                boards[i].undoMove(move);
+            }
+            applied += static_cast<std::int64_t>(moves[i].size());
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(applied);
+}
+BENCHMARK(BM_ApplyUndo)->ArgName("placement")->Arg(1)->Arg(0);
+
+void BM_GenerateMoves(benchmark::State& state) {
+    const auto& positions = corpus();
+    std::int64_t generated = 0;
+    MoveList moves;
+    for (auto _ : state) {
+        for (const Board& board : positions) {
+            moves.clear();
+            board.generateMoves(moves);
+            generated += static_cast<std::int64_t>(moves.size());
+        }
+        benchmark::DoNotOptimize(moves);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+    state.counters["moves"] = benchmark::Counter(static_cast<double>(generated), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GenerateMoves);
+
+void BM_GeneratePieceMoves(benchmark::State& state) {
+    const Piece piece = static_cast<Piece>(state.range(0));
+    state.SetLabel(std::string(1, pieceChar(piece)));
+    const auto& positions = corpus();
+    std::int64_t generated = 0;
+    MoveList moves;
+    for (auto _ : state) {
+        for (const Board& board : positions) {
+            moves.clear();
+            generatePieceMoves(board.getState(), board.getPlayerTurn(), piece, moves);
+            generated += static_cast<std::int64_t>(moves.size());
+        }
+        benchmark::DoNotOptimize(moves);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+    state.counters["moves"] = benchmark::Counter(static_cast<double>(generated), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GeneratePieceMoves)
+    ->ArgName("piece")
+    ->Arg(pieceIndex(Piece::King))
+    ->Arg(pieceIndex(Piece::Knight))
+    ->Arg(pieceIndex(Piece::Bishop))
+    ->Arg(pieceIndex(Piece::Rook));
+
+void BM_GeneratePlacements(benchmark::State& state) {
+    const auto& positions = corpus();
+    MoveList moves;
+    for (auto _ : state) {
+        for (const Board& board : positions) {
+            moves.clear();
+            generatePlacements(board.getState(), board.getHand(board.getPlayerTurn()), moves);
+        }
+        benchmark::DoNotOptimize(moves);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK(BM_GeneratePlacements);
+
+void BM_IsControlled(benchmark::State& state) {
+    const auto& positions = corpus();
+    for (auto _ : state) {
+        int controlled = 0;
+        for (const Board& board : positions) {
+            for (int sq = 0; sq < SQUARE_COUNT; ++sq) {
+                controlled += board.isControlled({fileOf(sq), rankOf(sq)}, 1);
+            }
+        }
+        benchmark::DoNotOptimize(controlled);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()) * SQUARE_COUNT);
+}
+BENCHMARK(BM_IsControlled);
+
+void BM_Score(benchmark::State& state) {
+    const auto& positions = corpus();
+    for (auto _ : state) {
+        int total = 0;
+        for (const Board& board : positions) {
+            total += board.countTerritory(1) + board.countTerritory(2) + board.getScore(1) + board.getScore(2);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK(BM_Score);
+
+// Full territory rebuild, the cost incremental scoring avoids per move.
+void BM_TerritoryRecompute(benchmark::State& state) {
+    const auto& positions = corpus();
+    Territory territory;
+    for (auto _ : state) {
+        for (const Board& board : positions) {
+            territory.recompute(board.getState());
+            benchmark::DoNotOptimize(territory);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK(BM_TerritoryRecompute);
+
+void BM_IsGameOver(benchmark::State& state) {
+    const auto& positions = corpus();
+    for (auto _ : state) {
+        int over = 0;
+        for (const Board& board : positions) {
+            int winner = 0;
+            over += board.isGameOver(winner);
+        }
+        benchmark::DoNotOptimize(over);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK(BM_IsGameOver);
+
+void BM_TableProbe(benchmark::State& state) {
+    TranspositionTable table(16);
+    const auto& positions = corpus();
+    const Move move{Move::NO_SQUARE, 60, Piece::Stone, Piece::None};
+    for (const Board& board : positions) {
+        table.store(board.getHash(), move, 0, 1, TranspositionTable::Bound::Exact);
+    }
+    TranspositionTable::Entry entry;
+    std::uint64_t key = 0;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        // Alternate hits and (almost certain) misses.
+        key = (i & 1) ? key * 0x9E3779B97F4A7C15ULL + 1 : positions[i % positions.size()].getHash();
+        benchmark::DoNotOptimize(table.probe(key, entry));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TableProbe);
+
+void BM_Perft(benchmark::State& state) {
+    Board board = corpus()[corpus().size() / 2];
+    std::uint64_t nodes = 0;
+    for (auto _ : state) {
+        nodes += perft(board, static_cast<int>(state.range(0)));
+    }
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Perft)->ArgName("depth")->Arg(2)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
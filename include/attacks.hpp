@@ -0,0 +1,126 @@
+#ifndef ATTACKS_HPP
+#define ATTACKS_HPP
+
+#include "bitboard.hpp"
+#include "board_state.hpp"
+#include <array>
+#include <cstddef>
+
+// Attack sets on the empty 11x11 board, built at compile time.
+//
+// Leapers (King, Knight) are a single table lookup. Sliders (Bishop, Rook)
+// use one ray table per direction: the attacked squares in a direction are
+// the ray cut off just after the nearest blocker, found with a bit scan.
+// Stones and pieces of either side all block sliders.
+namespace attacks_detail {
+
+struct Offset {
+    int dx;
+    int dy;
+};
+
+constexpr std::array<Offset, 8> KING_OFFSETS = {{
+    {-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}
+}};
+
+// Stones do not attack, but hold their orthogonal neighbours for territory.
+constexpr std::array<Offset, 4> STONE_OFFSETS = {{
+    {0, -1}, {-1, 0}, {1, 0}, {0, 1}
+}};
+
+constexpr std::array<Offset, 8> KNIGHT_OFFSETS = {{
+    {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}
+}};
+
+// Directions 0-3 increase the square index (scan with lsb), 4-7 decrease it
+// (scan with msb). Even entries are orthogonal, odd entries diagonal.
+constexpr std::array<Offset, 8> RAY_OFFSETS = {{
+    {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
+}};
+
+constexpr bool onBoard(int x, int y) {
+    return x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE;
+}
+
+template <std::size_t N>
+constexpr std::array<Bitboard, SQUARE_COUNT> makeLeaperTable(const std::array<Offset, N>& offsets) {
+    std::array<Bitboard, SQUARE_COUNT> table{};
+    for (int sq = 0; sq < SQUARE_COUNT; ++sq) {
+        for (const auto& [dx, dy] : offsets) {
+            int x = fileOf(sq) + dx;
+            int y = rankOf(sq) + dy;
+            if (onBoard(x, y)) {
+                table[sq].set(squareOf(x, y));
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<std::array<Bitboard, SQUARE_COUNT>, 8> makeRayTable() {
+    std::array<std::array<Bitboard, SQUARE_COUNT>, 8> table{};
+    for (int dir = 0; dir < 8; ++dir) {
+        for (int sq = 0; sq < SQUARE_COUNT; ++sq) {
+            int x = fileOf(sq) + RAY_OFFSETS[dir].dx;
+            int y = rankOf(sq) + RAY_OFFSETS[dir].dy;
+            for (; onBoard(x, y); x += RAY_OFFSETS[dir].dx, y += RAY_OFFSETS[dir].dy) {
+                table[dir][sq].set(squareOf(x, y));
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr auto KING_TABLE = makeLeaperTable(KING_OFFSETS);
+inline constexpr auto KNIGHT_TABLE = makeLeaperTable(KNIGHT_OFFSETS);
+inline constexpr auto RAY_TABLE = makeRayTable();
+inline constexpr auto STONE_TABLE = makeLeaperTable(STONE_OFFSETS);
+
+constexpr Bitboard rayAttacks(int dir, int sq, const Bitboard& occupied) {
+    Bitboard ray = RAY_TABLE[dir][sq];
+    Bitboard blockers = ray & occupied;
+    if (blockers.any()) {
+        int blocker = dir < 4 ? blockers.lsb() : blockers.msb();
+        ray ^= RAY_TABLE[dir][blocker];
+    }
+    return ray;
+}
+
+} // namespace attacks_detail
+
+constexpr Bitboard kingAttacks(int sq) { return attacks_detail::KING_TABLE[sq]; }
+constexpr Bitboard knightAttacks(int sq) { return attacks_detail::KNIGHT_TABLE[sq]; }
+
+constexpr Bitboard rookAttacks(int sq, const Bitboard& occupied) {
+    using attacks_detail::rayAttacks;
+    return rayAttacks(0, sq, occupied) | rayAttacks(2, sq, occupied)
+         | rayAttacks(4, sq, occupied) | rayAttacks(6, sq, occupied);
+}
+
+constexpr Bitboard bishopAttacks(int sq, const Bitboard& occupied) {
+    using attacks_detail::rayAttacks;
+    return rayAttacks(1, sq, occupied) | rayAttacks(3, sq, occupied)
+         | rayAttacks(5, sq, occupied) | rayAttacks(7, sq, occupied);
+}
+
+// Squares a piece on 'sq' attacks. Stones are immovable and attack nothing.
+constexpr Bitboard attacksFrom(Piece piece, int sq, const Bitboard& occupied) {
+    switch (piece) {
+        case Piece::King: return kingAttacks(sq);
+        case Piece::Knight: return knightAttacks(sq);
+        case Piece::Bishop: return bishopAttacks(sq, occupied);
+        case Piece::Rook: return rookAttacks(sq, occupied);
+        default: return Bitboard{};
+    }
+}
+
+// Squares a piece on 'sq' holds for territory: its own square plus its
+// attacks. A Stone holds its square and the four orthogonal neighbours.
+constexpr Bitboard controlFrom(Piece piece, int sq, const Bitboard& occupied) {
+    Bitboard control = piece == Piece::Stone ? attacks_detail::STONE_TABLE[sq]
+                                             : attacksFrom(piece, sq, occupied);
+    control.set(sq);
+    return control;
+}
+
+#endif
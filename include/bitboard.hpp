@@ -0,0 +1,63 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <bit>
+#include <cstdint>
+
+// Squares are numbered row-major: sq = y * BOARD_SIZE + x.
+constexpr int BOARD_SIZE = 11;
+constexpr int SQUARE_COUNT = BOARD_SIZE * BOARD_SIZE;
+
+constexpr int squareOf(int x, int y) { return y * BOARD_SIZE + x; }
+constexpr int fileOf(int sq) { return sq % BOARD_SIZE; }
+constexpr int rankOf(int sq) { return sq / BOARD_SIZE; }
+
+// 121-bit set of squares: bits 0..63 live in lo, bits 64..120 in hi.
+struct Bitboard {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    static constexpr std::uint64_t HI_MASK = (std::uint64_t{1} << (SQUARE_COUNT - 64)) - 1;
+
+    static constexpr Bitboard square(int sq) {
+        return sq < 64 ? Bitboard{std::uint64_t{1} << sq, 0}
+                       : Bitboard{0, std::uint64_t{1} << (sq - 64)};
+    }
+    static constexpr Bitboard full() { return Bitboard{~std::uint64_t{0}, HI_MASK}; }
+
+    constexpr bool test(int sq) const {
+        return sq < 64 ? (lo >> sq) & 1 : (hi >> (sq - 64)) & 1;
+    }
+    constexpr void set(int sq) { *this |= square(sq); }
+    constexpr void reset(int sq) { *this &= ~square(sq); }
+    constexpr void flip(int sq) { *this ^= square(sq); }
+
+    constexpr bool empty() const { return (lo | hi) == 0; }
+    constexpr bool any() const { return !empty(); }
+    constexpr int count() const { return std::popcount(lo) + std::popcount(hi); }
+
+    // Index of the lowest set square; undefined on an empty board.
+    constexpr int lsb() const {
+        return lo ? std::countr_zero(lo) : 64 + std::countr_zero(hi);
+    }
+    // Index of the highest set square; undefined on an empty board.
+    constexpr int msb() const {
+        return hi ? 127 - std::countl_zero(hi) : 63 - std::countl_zero(lo);
+    }
+    constexpr int popLsb() {
+        int sq = lsb();
+        if (lo) lo &= lo - 1; else hi &= hi - 1;
+        return sq;
+    }
+
+    constexpr Bitboard operator&(const Bitboard& o) const { return {lo & o.lo, hi & o.hi}; }
+    constexpr Bitboard operator|(const Bitboard& o) const { return {lo | o.lo, hi | o.hi}; }
+    constexpr Bitboard operator^(const Bitboard& o) const { return {lo ^ o.lo, hi ^ o.hi}; }
+    constexpr Bitboard operator~() const { return {~lo, ~hi & HI_MASK}; }
+    constexpr Bitboard& operator&=(const Bitboard& o) { lo &= o.lo; hi &= o.hi; return *this; }
+    constexpr Bitboard& operator|=(const Bitboard& o) { lo |= o.lo; hi |= o.hi; return *this; }
+    constexpr Bitboard& operator^=(const Bitboard& o) { lo ^= o.lo; hi ^= o.hi; return *this; }
+    constexpr bool operator==(const Bitboard&) const = default;
+};
+
+#endif
@@ -1,11 +1,11 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
 
+#include "board_state.hpp"
+#include "movegen.hpp"
+#include "territory.hpp"
 #include <array>
-#include <string>
-#include <map>
-#include <vector>
-#include <utility>
+#include <cstdint>
 
 struct Position {
     int x;
@@ -15,51 +15,97 @@ struct Position {
     }
 };
 
+// Tunable rule parameters; the defaults are the rules in Gameplay.md.
+// Board::initialize clamps the counts to the limits below.
+struct RuleSet {
+    static constexpr int MAX_STONES = 15;
+    static constexpr int MAX_TURNS = 60;
+
+    int stones = 10;          // Stones per player, 0 to MAX_STONES
+    int max_turns = 30;       // 1 to MAX_TURNS
+    int central_bonus = 1;    // extra points per controlled Central Region square
+    int capture_bonus = 3;
+
+    Inventory startingHand() const {
+        return {0, static_cast<std::uint8_t>(stones), 1, 2, 1, 1};  // None, S, K, N, B, R
+    }
+};
+
+// Rules and state of a game in progress: piece positions, what each player
+// still holds in hand, captures, whose turn it is and the turn count.
+//
+// Board does no I/O. Front ends and simulations drive it through
+// generateMoves/applyMove/undoMove (or the checked placePiece/movePiece)
+// and poll isGameOver.
 class Board {
 private:
-    static const int size = 11;
-    static const int central_size = 5;
-    static constexpr const char* EMPTY_CELL = "·";  // UTF-8 middle dot
-
-    std::array<std::array<std::string, size>, size> grid;
-    int cursor_x = 0;
-    int cursor_y = 0;
-    
-    Position selected_pos{-1, -1};
-    bool has_selection = false;
-    std::vector<Position> valid_moves;
-
-    bool isValidPosition(const Position& pos) const;
-    bool isCentralRegion(const Position& pos) const;
-    bool isPathClear(const Position& from, const Position& to) const;
-    bool isValidPieceMove(const std::string& piece, const Position& from, const Position& to) const;
+    static const int size = BOARD_SIZE;
+
+    RuleSet rules;
+    BoardState state;
+    Territory territory;
+    std::array<Inventory, PLAYER_COUNT> hands{};
+    std::array<int, PLAYER_COUNT> captures{};
+    int first_player = 1;
+    int player_turn = 1;
+    int turn_count = 1;
+    std::uint64_t hash = 0;
+
+    bool isValidPieceMove(Piece piece, const Position& from, const Position& to) const;
+    void updateTerritory(const Move& move);
+    void hashMove(const Move& move, int player);
+
+public:
+    Board() { initialize(); }
+    void initialize(int first = 1, const RuleSet& rule_set = {});
+
+    static bool isValidPosition(const Position& pos);
+    static int toSquare(const Position& pos) { return squareOf(pos.x, pos.y); }
+
+    const RuleSet& getRules() const { return rules; }
+    const BoardState& getState() const { return state; }
+    const Territory& getTerritory() const { return territory; }
+    const Inventory& getHand(int player) const { return hands[player - 1]; }
+    int getCaptures(int player) const { return captures[player - 1]; }
+    int getPlayerTurn() const { return player_turn; }
+    int getTurnCount() const { return turn_count; }
+    // Zobrist key of the position, updated incrementally by every move.
+    std::uint64_t getHash() const { return hash; }
+    std::uint64_t computeHash() const;
+
+    Piece getPieceAt(const Position& pos) const { return state.pieceAt(toSquare(pos)); }
     bool isPieceOwner(const Position& pos, int player) const;
     bool isOpponentPiece(const Position& pos, int player) const;
-    std::string getPieceAt(const Position& pos) const;
-    void setPieceAt(const Position& pos, const std::string& piece);
-    void updateValidMoves();
-    std::string colorPiece(const std::string& piece, int y) const;
+    Bitboard getValidTargets(const Position& from) const;
 
-public:
-    Board() = default;
-    void initialize();
-    void display(const std::map<std::string, int>& current_pieces, int turn_count, int player_turn) const;
+    // Checked moves for the player to move; return false if illegal.
+    bool placePiece(Piece piece, const Position& pos);
+    bool movePiece(const Position& from, const Position& to);
+
+    // Unchecked moves; 'move' must come from generateMoves (or be legal), and
+    // undoMove must be given the same move, in reverse order of application.
+    void generateMoves(MoveList& moves) const;
+    void applyMove(const Move& move);
+    void undoMove(const Move& move);
+
+    // The game ends when a King is lost, after the last turn, or when the
+    // player to move has no legal move; the latter two are decided on score
+    // with Central Region control breaking ties. 'winner' is 0 for a draw.
     bool isGameOver(int& winner) const;
-    int getScore(int player) const;
 
-    void moveCursor(int input);
-    int getCursorX() const { return cursor_x; }
-    int getCursorY() const { return cursor_y; }
-    void clearSelection();
-
-    bool selectPiece(int player_turn);
-    bool placePiece(const std::string& piece, int player_turn);
-    bool movePiece();
-    bool hasPieceMoved() const { return has_selection; }
-    
-    int countTerritory(int player) const;
-    int countCentralTerritory(int player) const;
-    bool isControlled(const Position& pos, int player) const;
+    // Scoring reads running totals that applyMove/undoMove keep current, so
+    // these are O(1). Define STRATEGOS_CHECK_TERRITORY to verify them against
+    // a full recomputation after every move.
+    int getScore(int player) const;
+    int countTerritory(int player) const { return territory.count(player); }
+    int countCentralTerritory(int player) const { return territory.centralCount(player); }
+    bool isControlled(const Position& pos, int player) const {
+        return territory.controller(toSquare(pos)) == player;
+    }
 };
 
-#endif
\ No newline at end of file
+// Counts leaf nodes of the move tree to 'depth' plies from the current
+// position, stopping lines where the game ends.
+std::uint64_t perft(Board& board, int depth);
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef BOARD_STATE_HPP
+#define BOARD_STATE_HPP
+
+#include "bitboard.hpp"
+#include <array>
+#include <cstdint>
+
+enum class Piece : std::uint8_t {
+    None = 0,
+    Stone,
+    King,
+    Knight,
+    Bishop,
+    Rook
+};
+
+constexpr int PIECE_TYPES = 6;  // including Piece::None
+constexpr int PLAYER_COUNT = 2;
+
+// Pieces a player still has in hand, indexed by pieceIndex().
+using Inventory = std::array<std::uint8_t, PIECE_TYPES>;
+
+constexpr int pieceIndex(Piece piece) { return static_cast<int>(piece); }
+
+constexpr char pieceChar(Piece piece) {
+    constexpr char chars[PIECE_TYPES] = {'.', 'S', 'K', 'N', 'B', 'R'};
+    return chars[pieceIndex(piece)];
+}
+
+constexpr Piece pieceFromChar(char c) {
+    switch (c) {
+        case 'S': return Piece::Stone;
+        case 'K': return Piece::King;
+        case 'N': return Piece::Knight;
+        case 'B': return Piece::Bishop;
+        case 'R': return Piece::Rook;
+        default: return Piece::None;
+    }
+}
+
+// Position of every piece on the 11x11 board. Plain data: copying it is a
+// memcpy of a few hundred bytes and all queries are bit operations.
+//
+// Players are numbered 1 and 2 as elsewhere in the game. Each mailbox byte
+// packs the piece type in the low 3 bits and (player - 1) in bit 3, so an
+// empty square is 0.
+class BoardState {
+public:
+    static constexpr std::uint8_t PIECE_MASK = 0x07;
+    static constexpr std::uint8_t OWNER_SHIFT = 3;
+
+    void clear() { *this = BoardState{}; }
+
+    Piece pieceAt(int sq) const { return static_cast<Piece>(mailbox[sq] & PIECE_MASK); }
+    // Owning player (1 or 2), or 0 for an empty square.
+    int ownerAt(int sq) const {
+        return mailbox[sq] ? (mailbox[sq] >> OWNER_SHIFT) + 1 : 0;
+    }
+    bool isEmpty(int sq) const { return mailbox[sq] == 0; }
+
+    const Bitboard& pieces(int player, Piece piece) const {
+        return by_piece[player - 1][pieceIndex(piece)];
+    }
+    const Bitboard& occupancy(int player) const { return by_player[player - 1]; }
+    Bitboard occupancy() const { return by_player[0] | by_player[1]; }
+
+    void put(int sq, Piece piece, int player) {
+        Bitboard bit = Bitboard::square(sq);
+        by_piece[player - 1][pieceIndex(piece)] |= bit;
+        by_player[player - 1] |= bit;
+        mailbox[sq] = static_cast<std::uint8_t>(pieceIndex(piece) | ((player - 1) << OWNER_SHIFT));
+    }
+
+    void remove(int sq) {
+        Bitboard bit = Bitboard::square(sq);
+        int owner = ownerAt(sq);
+        by_piece[owner - 1][pieceIndex(pieceAt(sq))] ^= bit;
+        by_player[owner - 1] ^= bit;
+        mailbox[sq] = 0;
+    }
+
+    // Moves the piece on 'from' to the empty square 'to'.
+    void move(int from, int to) {
+        Bitboard change = Bitboard::square(from) | Bitboard::square(to);
+        int owner = ownerAt(from);
+        by_piece[owner - 1][pieceIndex(pieceAt(from))] ^= change;
+        by_player[owner - 1] ^= change;
+        mailbox[to] = mailbox[from];
+        mailbox[from] = 0;
+    }
+
+    bool operator==(const BoardState&) const = default;
+
+private:
+    std::array<std::array<Bitboard, PIECE_TYPES>, PLAYER_COUNT> by_piece{};
+    std::array<Bitboard, PLAYER_COUNT> by_player{};
+    std::array<std::uint8_t, SQUARE_COUNT> mailbox{};
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef BOARD_VIEW_HPP
+#define BOARD_VIEW_HPP
+
+#include "board.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct RenderStats {
+    std::uint64_t frames = 0;
+    std::uint64_t skipped = 0;      // frames dropped to stay within the budget
+    std::uint64_t over_budget = 0;  // frames that took longer than the budget
+    std::uint64_t cells = 0;        // board cells redrawn
+    std::uint64_t lines = 0;        // status lines redrawn
+    std::uint64_t bytes = 0;        // bytes ncurses wrote to the terminal; 0 where not measurable
+    std::chrono::microseconds render_time{0};  // spent inside display()
+    std::chrono::microseconds elapsed{0};      // from the first frame to the last
+
+    // Frames actually shown per second of wall-clock time.
+    double framesPerSecond() const {
+        return elapsed.count() > 0 ? (frames - 1) * 1e6 / elapsed.count() : 0.0;
+    }
+    // Frames per second the renderer could sustain, from its time per frame.
+    double maxFramesPerSecond() const {
+        return render_time.count() > 0 ? frames * 1e6 / render_time.count() : 0.0;
+    }
+    double bytesPerFrame() const { return frames ? static_cast<double>(bytes) / frames : 0.0; }
+};
+
+// ncurses rendering of a Board, kept out of the rules so the core builds
+// and runs without a terminal.
+//
+// The view remembers the last frame it drew and only touches the cells and
+// status lines that changed since, so a keypress that moves the cursor
+// sends a few bytes instead of repainting the screen. Glyphs and their
+// attributes are looked up in a table built once, and nothing is formatted
+// into a new string per frame.
+//
+// Frames are paced by a budget: while more input is already waiting, a
+// frame that comes sooner than the budget after the previous one is
+// skipped, so a burst of queued keys over a slow link costs one redraw per
+// budget instead of one per key. The last state is always drawn.
+class BoardView {
+public:
+    static constexpr std::chrono::microseconds FRAME_BUDGET{16'667};  // 60 frames per second
+
+    BoardView();
+    ~BoardView();
+    BoardView(const BoardView&) = delete;
+    BoardView& operator=(const BoardView&) = delete;
+
+    // Draws the frame, or skips it when 'input_pending' and the budget since
+    // the previous frame has not run out. Returns whether it drew.
+    bool display(const Board& board, const Position& cursor, const std::vector<Position>& highlights,
+                 const std::string& status, bool input_pending = false);
+
+    // Forgets the last frame, e.g. after something else drew on the screen
+    // or the terminal was resized; the next display() repaints everything.
+    void invalidate() { valid = false; }
+
+    // Adds a line with the render counters below the status line.
+    void setShowStats(bool show) { show_stats = show; }
+    const RenderStats& getStats() const { return stats; }
+
+private:
+    struct Glyph {
+        const char* text;
+        int attrs;
+
+        bool operator==(const Glyph&) const = default;
+    };
+
+    static constexpr int STATUS_LINES = 5;
+
+    void drawLine(int row, int index, const char* text);
+    std::uint64_t bytesWritten() const;
+
+    std::array<std::array<Glyph, PLAYER_COUNT + 1>, PIECE_TYPES> glyphs;
+    std::array<Glyph, SQUARE_COUNT> frame;
+    std::array<std::string, STATUS_LINES> lines;
+    bool valid = false;
+    bool show_stats = false;
+
+    std::chrono::steady_clock::time_point first_frame;
+    std::chrono::steady_clock::time_point last_frame;
+    int io_stats = -1;  // /proc/self/io, for the bytes ncurses writes
+    RenderStats stats;
+};
+
+#endif
@@ -1,31 +1,54 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
-#include <map>
+#include "board.hpp"
+#include "board_view.hpp"
+#include "search.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
-class Board;
+enum class PlayerType {
+    Human,
+    Computer
+};
 
+// Terminal front end: reads keys or asks the search for a move, drives the
+// Board and draws it.
 class Game {
 private:
-    Board* board;
-    int turn_count = 1;
-    int player_turn = 1;
-    bool piece_selected = false;
-    
-    std::map<std::string, int> player1_pieces;
-    std::map<std::string, int> player2_pieces;
+    Board board;
+    BoardView view;
+    std::unique_ptr<Search> search;  // created on the computer's first move
+    std::array<PlayerType, PLAYER_COUNT> players;
+    SearchLimits search_limits;
+    std::size_t table_megabytes;
+    std::string status;
+    Position cursor{0, 0};
+
+    Position selected_pos{-1, -1};
+    bool has_selection = false;
+    std::vector<Position> valid_moves;
 
-    void initializePieces();
     void handleInput(int input, bool& game_running);
-    std::map<std::string, int>& getCurrentPlayerPieces();
+    bool playComputerMove();
+    bool isInputPending() const;
+    void moveCursor(int input);
+    void selectPiece();
+    void moveSelectedPiece();
+    void clearSelection();
     void showStartScreen() const;
     void showEndScreen(int winner) const;
 
 public:
-    Game();
-    ~Game();
+    explicit Game(std::array<PlayerType, PLAYER_COUNT> player_types = {PlayerType::Human, PlayerType::Human},
+                  const SearchLimits& limits = {}, std::size_t table_megabytes = 64)
+        : players(player_types), search_limits(limits), table_megabytes(table_megabytes) {}
     void start();
+    // Shows the renderer's frame and byte counters under the status line.
+    void setShowRenderStats(bool show) { view.setShowStats(show); }
 };
 
-#endif
\ No newline at end of file
+#endif
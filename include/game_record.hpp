@@ -0,0 +1,120 @@
+#ifndef GAME_RECORD_HPP
+#define GAME_RECORD_HPP
+
+#include "board.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+// Compact binary game records.
+//
+// File layout, all little-endian:
+//   header  "STGR", version byte, stones, max_turns, central_bonus,
+//           capture_bonus (signed bytes), 3 reserved bytes: 12 bytes
+//   games   back to back, each starting on a byte boundary:
+//           LEB128 move count
+//           1 byte: bit 0 = first player - 1, bits 1-2 = winner (0 = draw)
+//           moves, bit-packed LSB first, padded to a whole byte:
+//             placement: 1, piece type (3 bits), to (7 bits)      = 11 bits
+//             piece move: 0, piece type (3 bits), from, to (7 each) = 18 bits
+//
+// Captured pieces are not stored; replay() recovers them from the board.
+namespace game_record {
+
+constexpr char MAGIC[4] = {'S', 'T', 'G', 'R'};
+constexpr std::uint8_t VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 12;
+
+} // namespace game_record
+
+// A game inside a mapped record file. 'moves' points into the mapping.
+struct RecordedGame {
+    std::size_t offset = 0;      // byte offset of the game in the file
+    std::size_t size = 0;        // encoded size in bytes
+    int first_player = 1;
+    int winner = 0;
+    std::uint32_t move_count = 0;
+    const std::uint8_t* moves = nullptr;
+};
+
+// Decodes the moves of a RecordedGame one at a time. Decoded moves have
+// 'captured' set to Piece::None.
+class RecordedMoveReader {
+public:
+    explicit RecordedMoveReader(const RecordedGame& game)
+        : data(game.moves), remaining(game.move_count) {}
+
+    bool next(Move& move);
+
+private:
+    std::uint32_t readBits(int count);
+
+    const std::uint8_t* data;
+    std::uint32_t remaining;
+    std::size_t bit = 0;
+};
+
+// Append-only writer. Opening an existing file with the same rules appends
+// to it. writeGame is safe to call from several threads.
+class GameRecordWriter {
+public:
+    GameRecordWriter() = default;
+    ~GameRecordWriter() { close(); }
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+    // Fails if the file cannot be opened, was written with other rules, or
+    // the rules are out of range: counts beyond RuleSet's limits or bonuses
+    // outside -128..127.
+    bool open(const std::string& path, const RuleSet& rules);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    bool writeGame(int first_player, int winner, std::span<const Move> moves);
+    bool flush();
+
+private:
+    std::FILE* file = nullptr;
+    std::vector<std::uint8_t> buffer;
+    std::mutex mutex;
+};
+
+// Read-only memory-mapped view of a record file. Games are decoded in place
+// straight from the mapping, with no parsing or copying.
+class GameRecordReader {
+public:
+    GameRecordReader() = default;
+    ~GameRecordReader() { close(); }
+    GameRecordReader(const GameRecordReader&) = delete;
+    GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const RuleSet& getRules() const { return rules; }
+
+    // Sequential access: start at firstGame() and continue from
+    // game.offset + game.size. Returns false at the end or on a truncated
+    // game.
+    std::size_t firstGame() const { return game_record::HEADER_SIZE; }
+    bool readGame(std::size_t offset, RecordedGame& game) const;
+    // Byte offsets of every game, for random access with readGame.
+    std::vector<std::size_t> buildIndex() const;
+
+    // Plays 'game' out on 'board' from the start with the file's rules;
+    // captures are recovered from the board. Returns false if a move is not
+    // legal.
+    bool replay(const RecordedGame& game, Board& board) const;
+
+private:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    RuleSet rules;
+};
+
+#endif
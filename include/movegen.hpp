@@ -0,0 +1,60 @@
+#ifndef MOVEGEN_HPP
+#define MOVEGEN_HPP
+
+#include "board_state.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Trivially constructible so move buffers cost nothing to create.
+struct Move {
+    static constexpr std::uint8_t NO_SQUARE = 0xFF;
+
+    std::uint8_t from;  // NO_SQUARE for a placement from hand
+    std::uint8_t to;
+    Piece piece;
+    Piece captured;
+
+    bool isPlacement() const { return from == NO_SQUARE; }
+    bool isCapture() const { return captured != Piece::None; }
+    bool operator==(const Move&) const = default;
+};
+
+// Fixed-capacity move buffer; generating moves never allocates.
+class MoveList {
+public:
+    // Placements of every piece type on every square plus all piece moves.
+    static constexpr std::size_t CAPACITY = 1024;
+
+    void clear() { count = 0; }
+    void push(const Move& move) { moves[count++] = move; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Move& operator[](std::size_t i) const { return moves[i]; }
+    Move& operator[](std::size_t i) { return moves[i]; }
+
+    const Move* begin() const { return moves.data(); }
+    const Move* end() const { return moves.data() + count; }
+    Move* begin() { return moves.data(); }
+    Move* end() { return moves.data() + count; }
+
+private:
+    std::array<Move, CAPACITY> moves;
+    std::size_t count = 0;
+};
+
+// Squares the piece on 'sq' may move to: its attack set minus friendly
+// pieces and Stones, which can never be captured.
+Bitboard legalTargets(const BoardState& state, int sq);
+
+// Appends every move of 'player's pieces of the given type.
+void generatePieceMoves(const BoardState& state, int player, Piece piece, MoveList& moves);
+// Appends a placement on every empty square for each piece type in hand.
+void generatePlacements(const BoardState& state, const Inventory& hand, MoveList& moves);
+// Appends all legal moves for 'player': placements first, then piece moves.
+void generateMoves(const BoardState& state, const Inventory& hand, int player, MoveList& moves);
+// Whether generateMoves would append anything, without generating.
+bool hasMoves(const BoardState& state, const Inventory& hand, int player);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include "board.hpp"
+#include "transposition_table.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SearchLimits {
+    std::chrono::milliseconds move_time{1000};
+    int max_depth = 32;
+    int threads = 1;
+};
+
+struct SearchResult {
+    Move best_move{Move::NO_SQUARE, Move::NO_SQUARE, Piece::None, Piece::None};
+    int score = 0;        // from the point of view of the player to move
+    int depth = 0;        // last fully searched depth
+    std::uint64_t nodes = 0;
+    std::chrono::microseconds elapsed{0};
+    TranspositionTable::Stats table_stats;  // this search only
+    int hashfull = 0;                       // per mille
+
+    double nodesPerSecond() const {
+        return elapsed.count() > 0 ? nodes * 1e6 / elapsed.count() : 0.0;
+    }
+};
+
+// Iterative-deepening alpha-beta search over a Board, parallelised by
+// lazy SMP.
+//
+// Every thread runs its own complete iterative deepening on its own copy of
+// the board, and the threads share only the transposition table. Helpers
+// start one ply deeper on odd thread numbers, so they quickly diverge and
+// fill the table with results the others then cut off on, instead of all
+// walking the same tree. No thread ever waits for another between
+// iterations; the answer is the deepest iteration any thread completed.
+// Within a thread captures, killer moves and central placements are
+// ordered first, and a capture-only quiescence search runs at the leaves.
+//
+// The helper threads are started on first use and kept between searches,
+// so a move costs no thread creation.
+class Search {
+public:
+    static constexpr int WIN_SCORE = 30000;  // fits the table's 16-bit scores
+
+    explicit Search(std::size_t table_megabytes = 64) : table(table_megabytes) {}
+    ~Search() { stopHelpers(); }
+    Search(const Search&) = delete;
+    Search& operator=(const Search&) = delete;
+
+    TranspositionTable& getTable() { return table; }
+
+    // Returns the best move for board.getPlayerTurn(). The board must not be
+    // over and must have at least one legal move.
+    SearchResult run(const Board& board, const SearchLimits& limits);
+
+    // Makes a running search return as soon as possible. Safe from any thread.
+    void stop() { stopped.store(true, std::memory_order_relaxed); }
+
+private:
+    void startHelpers(int count);
+    void stopHelpers();
+    void helperLoop(std::stop_token stop, int index, std::uint64_t done_id);
+    // Runs job(index) on every helper and job(0) here, and returns when all
+    // of them have.
+    void runOnAllThreads(const std::function<void(int)>& job);
+
+    std::atomic<bool> stopped{false};
+    TranspositionTable table;
+
+    std::mutex pool_mutex;
+    std::condition_variable_any work_ready;
+    std::condition_variable_any work_done;
+    const std::function<void(int)>* job = nullptr;
+    std::uint64_t job_id = 0;
+    int running = 0;
+    std::vector<std::jthread> helpers;
+};
+
+#endif
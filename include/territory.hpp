@@ -0,0 +1,50 @@
+#ifndef TERRITORY_HPP
+#define TERRITORY_HPP
+
+#include "board_state.hpp"
+#include <array>
+#include <cstdint>
+
+// Incrementally maintained board control.
+//
+// Every piece holds its own square plus the squares it attacks (a Stone
+// holds its orthogonal neighbours instead). A square is controlled by the
+// player holding it with more pieces than the opponent. Each square's
+// holder counts are kept, along with running totals of controlled squares,
+// so after a move only the pieces whose control set can have changed are
+// re-evaluated: the pieces on the changed squares and any Bishop or Rook
+// whose lines ran through them.
+class Territory {
+public:
+    void clear() { *this = Territory{}; }
+
+    // Brings control up to date with 'state' after the squares in 'changed'
+    // were emptied, filled or swapped. Call with the same squares to undo.
+    void update(const BoardState& state, const Bitboard& changed);
+    // Rebuilds everything from scratch.
+    void recompute(const BoardState& state);
+    // True if the running totals equal a full recomputation of 'state'.
+    bool matchesRecompute(const BoardState& state) const;
+
+    // Controlling player (1 or 2) of a square, or 0 if contested or empty.
+    int controller(int sq) const {
+        const int lead = influence[0][sq] - influence[1][sq];
+        return lead > 0 ? 1 : (lead < 0 ? 2 : 0);
+    }
+    int count(int player) const { return territory[player - 1]; }
+    int centralCount(int player) const { return central[player - 1]; }
+
+    bool operator==(const Territory&) const = default;
+
+private:
+    void adjust(int player, const Bitboard& squares, int delta);
+    void refresh(const BoardState& state, int sq);
+
+    std::array<std::array<std::uint8_t, SQUARE_COUNT>, PLAYER_COUNT> influence{};
+    std::array<Bitboard, SQUARE_COUNT> held{};             // control set of the piece on each square
+    std::array<std::uint8_t, SQUARE_COUNT> held_by{};      // owner of 'held', 0 if none
+    std::array<int, PLAYER_COUNT> territory{};
+    std::array<int, PLAYER_COUNT> central{};
+};
+
+#endif
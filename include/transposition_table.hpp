@@ -0,0 +1,87 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include "movegen.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size hash table of search results shared by all search threads
+// without locks.
+//
+// Entries are two 64-bit words: the packed data and the key XORed with that
+// data. Both are written and read with relaxed atomics; if two threads race
+// on an entry, the stored key no longer matches and the probe is a miss,
+// so a torn entry is never returned. Entries come in 64-byte clusters
+// aligned to a cache line, so a probe touches a single line.
+class TranspositionTable {
+public:
+    enum class Bound : std::uint8_t {
+        None = 0,
+        Exact,
+        Lower,  // score is at least this (fail high)
+        Upper   // score is at most this (fail low)
+    };
+
+    struct Entry {
+        Move move;
+        int score;
+        int depth;
+        Bound bound;
+    };
+
+    struct Stats {
+        std::uint64_t probes = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t stores = 0;
+
+        double hitRate() const { return probes ? static_cast<double>(hits) / probes : 0.0; }
+    };
+
+    explicit TranspositionTable(std::size_t megabytes = 64) { resize(megabytes); }
+
+    // Reallocates and clears. Not safe while a search is running.
+    void resize(std::size_t megabytes);
+    void clear();
+    // Starts a new search generation so older entries are replaced first.
+    void newSearch() { generation = static_cast<std::uint8_t>(generation + 1); }
+
+    bool probe(std::uint64_t key, Entry& entry) const;
+    void store(std::uint64_t key, const Move& move, int score, int depth, Bound bound);
+
+    std::size_t sizeInBytes() const { return cluster_count * sizeof(Cluster); }
+    // Per-mille of sampled entries written during the current generation.
+    int hashfull() const;
+
+    // Threads count probes locally and add them in here once per search,
+    // keeping shared counters off the hot path.
+    void addStats(const Stats& local);
+    Stats stats() const;
+
+private:
+    static constexpr int CLUSTER_SIZE = 4;
+
+    struct Slot {
+        std::atomic<std::uint64_t> key_xor_data{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    struct alignas(64) Cluster {
+        Slot slots[CLUSTER_SIZE];
+    };
+
+    static std::uint64_t pack(const Move& move, int score, int depth, Bound bound, std::uint8_t generation);
+    static Entry unpack(std::uint64_t data);
+
+    Cluster& clusterFor(std::uint64_t key) const;
+
+    std::unique_ptr<Cluster[]> clusters;
+    std::size_t cluster_count = 0;
+    std::uint8_t generation = 0;
+    std::atomic<std::uint64_t> total_probes{0};
+    std::atomic<std::uint64_t> total_hits{0};
+    std::atomic<std::uint64_t> total_stores{0};
+};
+
+#endif
@@ -1,9 +0,0 @@
-
-#ifndef UTILS_HPP
-#define UTILS_HPP
-
-#include <string>
-
-std::string color(const std::string& text, const std::string& color_name);
-
-#endif
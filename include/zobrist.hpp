@@ -0,0 +1,68 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include "board_state.hpp"
+#include <array>
+#include <cstdint>
+
+// Random keys for hashing a Board, generated at compile time. A position's
+// key is the XOR of the keys of everything that distinguishes it, so a move
+// updates it with a handful of XORs:
+//   - each piece on each square, per owner
+//   - the player to move
+//   - how many of each piece type each player still holds
+//   - each player's capture count (it feeds the score)
+//   - the turn count, since the 30-turn limit ends the game
+namespace zobrist {
+
+constexpr int MAX_HAND_COUNT = 16;
+constexpr int MAX_CAPTURE_COUNT = 16;
+constexpr int MAX_TURN_KEYS = 64;
+
+struct Keys {
+    std::array<std::array<std::array<std::uint64_t, SQUARE_COUNT>, PIECE_TYPES>, PLAYER_COUNT> piece{};
+    std::array<std::array<std::array<std::uint64_t, MAX_HAND_COUNT>, PIECE_TYPES>, PLAYER_COUNT> hand{};
+    std::array<std::array<std::uint64_t, MAX_CAPTURE_COUNT>, PLAYER_COUNT> captures{};
+    std::array<std::uint64_t, MAX_TURN_KEYS> turn{};
+    std::uint64_t player_two = 0;  // set when Player 2 is to move
+};
+
+// SplitMix64: small, fast and good enough for hash keys.
+constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr Keys makeKeys() {
+    Keys keys;
+    std::uint64_t state = 0x5354524154454753ULL;  // "STRATEGS"
+    for (auto& by_piece : keys.piece)
+        for (auto& by_square : by_piece)
+            for (auto& key : by_square) key = splitMix64(state);
+    for (auto& by_piece : keys.hand)
+        for (auto& by_count : by_piece)
+            for (auto& key : by_count) key = splitMix64(state);
+    for (auto& by_count : keys.captures)
+        for (auto& key : by_count) key = splitMix64(state);
+    for (auto& key : keys.turn) key = splitMix64(state);
+    keys.player_two = splitMix64(state);
+    return keys;
+}
+
+inline constexpr Keys KEYS = makeKeys();
+
+constexpr std::uint64_t piece(int player, Piece type, int sq) {
+    return KEYS.piece[player - 1][pieceIndex(type)][sq];
+}
+constexpr std::uint64_t hand(int player, Piece type, int count) {
+    return KEYS.hand[player - 1][pieceIndex(type)][count];
+}
+constexpr std::uint64_t captures(int player, int count) { return KEYS.captures[player - 1][count]; }
+constexpr std::uint64_t turn(int turn_count) { return KEYS.turn[turn_count]; }
+constexpr std::uint64_t playerTwo() { return KEYS.player_two; }
+
+} // namespace zobrist
+
+#endif
@@ -1,67 +1,224 @@
 #include "board.hpp"
-#include <ncurses.h>  // Ensure ncurses is included
-#include <spdlog/spdlog.h>
-#include <string>
-#include <sstream>
-
-void Board::initialize() {
-    spdlog::info("Initializing board...");
-    for (auto& row : grid) {
-        row.fill("·"); // Centered dot for empty cells
-    }
-}
-
-void Board::display(const std::map<std::string, int>& pieces, int player_turn) const {
-    clear(); // Clear the screen
-
-    // Display column labels
-    mvprintw(0, 4, "  A B C D E F G H I J K");
-
-    // Display rows and cells
-    for (int y = 0; y < size; ++y) {
-        mvprintw(y + 1, 0, "%2d ", y + 1); // Row label
-        for (int x = 0; x < size; ++x) {
-            if (x == cursor_x && y == cursor_y) {
-                attron(A_REVERSE); // Highlight the cursor
-                mvprintw(y + 1, 4 + x * 2, "%s", grid[y][x].c_str());
-                attroff(A_REVERSE);
-            } else if (grid[y][x] != "·") {
-                int color_pair = (player_turn == 1) ? 1 : 2; // Red for Player 1, Blue for Player 2
-                attron(COLOR_PAIR(color_pair));
-                mvprintw(y + 1, 4 + x * 2, "%s", grid[y][x].c_str());
-                attroff(COLOR_PAIR(color_pair));
-            } else {
-                mvprintw(y + 1, 4 + x * 2, "%s", grid[y][x].c_str());
-            }
+#include "zobrist.hpp"
+#include <algorithm>
+#ifdef STRATEGOS_CHECK_TERRITORY
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+// Hand counts and the turn count index the Zobrist tables; the turn count
+// runs one past max_turns, and its key one further while it is updated.
+static_assert(RuleSet::MAX_STONES < zobrist::MAX_HAND_COUNT);
+static_assert(RuleSet::MAX_TURNS + 2 < zobrist::MAX_TURN_KEYS);
+
+void Board::initialize(int first, const RuleSet& rule_set) {
+    rules = rule_set;
+    rules.stones = std::clamp(rules.stones, 0, RuleSet::MAX_STONES);
+    rules.max_turns = std::clamp(rules.max_turns, 1, RuleSet::MAX_TURNS);
+    state.clear();
+    territory.clear();
+    hands = {rules.startingHand(), rules.startingHand()};
+    captures = {};
+    first_player = first;
+    player_turn = first;
+    turn_count = 1;
+    hash = computeHash();
+}
+
+bool Board::isValidPosition(const Position& pos) {
+    return pos.x >= 0 && pos.x < size && pos.y >= 0 && pos.y < size;
+}
+
+bool Board::isPieceOwner(const Position& pos, int player) const {
+    return state.occupancy(player).test(toSquare(pos));
+}
+
+bool Board::isOpponentPiece(const Position& pos, int player) const {
+    return state.occupancy(3 - player).test(toSquare(pos));
+}
+
+bool Board::isValidPieceMove(Piece piece, const Position& from, const Position& to) const {
+    if (!isValidPosition(from) || !isValidPosition(to)) {
+        return false;
+    }
+    const int sq = toSquare(from);
+    return state.pieceAt(sq) == piece && legalTargets(state, sq).test(toSquare(to));
+}
+
+Bitboard Board::getValidTargets(const Position& from) const {
+    if (!isValidPosition(from) || !isPieceOwner(from, player_turn)) {
+        return Bitboard{};
+    }
+    return legalTargets(state, toSquare(from));
+}
+
+bool Board::placePiece(Piece piece, const Position& pos) {
+    if (piece == Piece::None || !isValidPosition(pos)
+        || hands[player_turn - 1][pieceIndex(piece)] == 0 || !state.isEmpty(toSquare(pos))) {
+        return false;
+    }
+    applyMove({Move::NO_SQUARE, static_cast<std::uint8_t>(toSquare(pos)), piece, Piece::None});
+    return true;
+}
+
+bool Board::movePiece(const Position& from, const Position& to) {
+    if (!isValidPosition(from) || !isPieceOwner(from, player_turn)) {
+        return false;
+    }
+    Piece piece = getPieceAt(from);
+    if (!isValidPieceMove(piece, from, to)) {
+        return false;
+    }
+    applyMove({static_cast<std::uint8_t>(toSquare(from)), static_cast<std::uint8_t>(toSquare(to)),
+               piece, getPieceAt(to)});
+    return true;
+}
+
+void Board::generateMoves(MoveList& moves) const {
+    ::generateMoves(state, hands[player_turn - 1], player_turn, moves);
+}
+
+void Board::applyMove(const Move& move) {
+    hashMove(move, player_turn);
+    if (move.isPlacement()) {
+        state.put(move.to, move.piece, player_turn);
+        --hands[player_turn - 1][pieceIndex(move.piece)];
+    } else {
+        if (move.isCapture()) {
+            state.remove(move.to);
+            ++captures[player_turn - 1];
         }
+        state.move(move.from, move.to);
     }
+    updateTerritory(move);
+
+    player_turn = 3 - player_turn;
+    hash ^= zobrist::playerTwo();
+    if (player_turn == first_player) {
+        hash ^= zobrist::turn(turn_count) ^ zobrist::turn(turn_count + 1);
+        ++turn_count;
+    }
+}
 
-    // Display available pieces and current player
-    mvprintw(size + 2, 0, "Player %d's turn.", player_turn);
-    mvprintw(size + 3, 0, "Available pieces:");
-    int offset = 20;
-    for (const auto& [piece, count] : pieces) {
-        mvprintw(size + 3, offset, "%s:%d", piece.c_str(), count);
-        offset += 10;
+void Board::undoMove(const Move& move) {
+    if (player_turn == first_player) {
+        hash ^= zobrist::turn(turn_count) ^ zobrist::turn(turn_count - 1);
+        --turn_count;
     }
+    player_turn = 3 - player_turn;
+    hash ^= zobrist::playerTwo();
 
-    refresh(); // Refresh the screen
+    if (move.isPlacement()) {
+        state.remove(move.to);
+        ++hands[player_turn - 1][pieceIndex(move.piece)];
+    } else {
+        state.move(move.to, move.from);
+        if (move.isCapture()) {
+            state.put(move.to, move.captured, 3 - player_turn);
+            --captures[player_turn - 1];
+        }
+    }
+    updateTerritory(move);
+    hashMove(move, player_turn);
+}
+
+// XORs a move's piece, hand and capture keys into the hash. Called before
+// applying and after undoing, so the counts seen are the pre-move ones.
+void Board::hashMove(const Move& move, int player) {
+    if (move.isPlacement()) {
+        const int count = hands[player - 1][pieceIndex(move.piece)];
+        hash ^= zobrist::piece(player, move.piece, move.to)
+              ^ zobrist::hand(player, move.piece, count) ^ zobrist::hand(player, move.piece, count - 1);
+        return;
+    }
+    hash ^= zobrist::piece(player, move.piece, move.from) ^ zobrist::piece(player, move.piece, move.to);
+    if (move.isCapture()) {
+        const int count = captures[player - 1];
+        hash ^= zobrist::piece(3 - player, move.captured, move.to)
+              ^ zobrist::captures(player, count) ^ zobrist::captures(player, count + 1);
+    }
 }
 
-void Board::moveCursor(int input) {
-    // Handle cursor movement
-    switch (input) {
-        case KEY_UP: if (cursor_y > 0) --cursor_y; break;
-        case KEY_DOWN: if (cursor_y < size - 1) ++cursor_y; break;
-        case KEY_LEFT: if (cursor_x > 0) --cursor_x; break;
-        case KEY_RIGHT: if (cursor_x < size - 1) ++cursor_x; break;
+std::uint64_t Board::computeHash() const {
+    std::uint64_t key = zobrist::turn(turn_count);
+    if (player_turn == 2) {
+        key ^= zobrist::playerTwo();
+    }
+    for (int player = 1; player <= PLAYER_COUNT; ++player) {
+        key ^= zobrist::captures(player, captures[player - 1]);
+        for (int i = 1; i < PIECE_TYPES; ++i) {
+            key ^= zobrist::hand(player, static_cast<Piece>(i), hands[player - 1][i]);
+        }
+        Bitboard pieces = state.occupancy(player);
+        while (pieces.any()) {
+            int sq = pieces.popLsb();
+            key ^= zobrist::piece(player, state.pieceAt(sq), sq);
+        }
+    }
+    return key;
+}
+
+void Board::updateTerritory(const Move& move) {
+    Bitboard changed = Bitboard::square(move.to);
+    if (!move.isPlacement()) {
+        changed.set(move.from);
+    }
+    territory.update(state, changed);
+#ifdef STRATEGOS_CHECK_TERRITORY
+    if (!territory.matchesRecompute(state)) {
+        std::fprintf(stderr, "Incremental territory diverged from full recompute\n");
+        std::abort();
     }
+#endif
 }
 
-bool Board::placePiece(const std::string& piece, int player_turn) {
-    if (grid[cursor_y][cursor_x] == "·") {
-        grid[cursor_y][cursor_x] = piece;
-        spdlog::info("Placed %s by Player %d at (%d, %d).", piece.c_str(), player_turn, cursor_y, cursor_x);
-        return true;
+bool Board::isGameOver(int& winner) const {
+    // A King is lost once it has left the hand and is no longer on the board.
+    for (int player = 1; player <= PLAYER_COUNT; ++player) {
+        if (hands[player - 1][pieceIndex(Piece::King)] == 0 && state.pieces(player, Piece::King).empty()) {
+            winner = 3 - player;
+            return true;
+        }
+    }
+
+    // Past the turn limit, or with nothing left to play, the score decides.
+    if (turn_count <= rules.max_turns && hasMoves(state, hands[player_turn - 1], player_turn)) {
+        return false;
+    }
+    const int score1 = getScore(1);
+    const int score2 = getScore(2);
+    if (score1 == score2) {
+        // Central Region control breaks ties.
+        const int central1 = countCentralTerritory(1);
+        const int central2 = countCentralTerritory(2);
+        winner = central1 == central2 ? 0 : (central1 > central2 ? 1 : 2);
     } else {
-        spdl
+        winner = score1 > score2 ? 1 : 2;
+    }
+    return true;
+}
+
+int Board::getScore(int player) const {
+    return countTerritory(player) + rules.central_bonus * countCentralTerritory(player)
+         + rules.capture_bonus * captures[player - 1];
+}
+
+std::uint64_t perft(Board& board, int depth) {
+    int winner = 0;
+    if (depth == 0 || board.isGameOver(winner)) {
+        return 1;
+    }
+    MoveList moves;
+    board.generateMoves(moves);
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    std::uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        board.applyMove(move);
+        nodes += perft(board, depth - 1);
+        board.undoMove(move);
+    }
+    return nodes;
+}
@@ -0,0 +1,163 @@
+#include "board_view.hpp"
+#include <ncurses.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr const char* EMPTY_CELL = "·";  // UTF-8 middle dot
+constexpr int STONE_COLOR_PAIR = 3;
+constexpr const char* PIECE_TEXT[PIECE_TYPES] = {EMPTY_CELL, "S", "K", "N", "B", "R"};
+
+constexpr int cellRow(int sq) { return rankOf(sq) + 1; }
+constexpr int cellColumn(int sq) { return 4 + fileOf(sq) * 2; }
+
+} // namespace
+
+BoardView::BoardView() {
+    for (int i = 0; i < PIECE_TYPES; ++i) {
+        const Piece piece = static_cast<Piece>(i);
+        for (int owner = 0; owner <= PLAYER_COUNT; ++owner) {
+            int attrs = A_NORMAL;
+            if (piece == Piece::Stone) {
+                attrs = COLOR_PAIR(STONE_COLOR_PAIR);
+            } else if (piece != Piece::None && owner != 0) {
+                attrs = COLOR_PAIR(owner); // Red for Player 1, Blue for Player 2
+            }
+            glyphs[i][owner] = {PIECE_TEXT[i], attrs};
+        }
+    }
+#ifdef __linux__
+    io_stats = ::open("/proc/self/io", O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+BoardView::~BoardView() {
+#ifdef __linux__
+    if (io_stats >= 0) {
+        ::close(io_stats);
+    }
+#endif
+}
+
+// Bytes the process has written so far. ncurses writes straight to the
+// terminal's file descriptor, so a wrapping FILE stream never sees its
+// output; the kernel's count does. Only display() runs while it is sampled,
+// so the difference across refresh() is exactly what reached the terminal.
+std::uint64_t BoardView::bytesWritten() const {
+#ifdef __linux__
+    char text[512];
+    const ssize_t length = io_stats >= 0 ? ::pread(io_stats, text, sizeof(text) - 1, 0) : -1;
+    if (length > 0) {
+        text[length] = '\0';
+        if (const char* wchar = std::strstr(text, "wchar: ")) {
+            return std::strtoull(wchar + 7, nullptr, 10);
+        }
+    }
+#endif
+    return 0;
+}
+
+bool BoardView::display(const Board& board, const Position& cursor, const std::vector<Position>& highlights,
+                        const std::string& status, bool input_pending) {
+    const auto start = std::chrono::steady_clock::now();
+    if (input_pending && stats.frames > 0 && start - last_frame < FRAME_BUDGET) {
+        ++stats.skipped;
+        return false;
+    }
+    const BoardState& state = board.getState();
+
+    if (!valid) {
+        // Only a full repaint erases; clear() would also make ncurses
+        // resend the whole screen on every frame.
+        erase();
+        mvaddstr(0, 4, "A B C D E F G H I J K");
+        char label[8];
+        for (int y = 0; y < BOARD_SIZE; ++y) {
+            std::snprintf(label, sizeof(label), "%2d ", y + 1);
+            mvaddstr(y + 1, 0, label);
+        }
+    }
+
+    Bitboard reachable;
+    for (const Position& pos : highlights) {
+        reachable.set(Board::toSquare(pos));
+    }
+    const int cursor_sq = Board::toSquare(cursor);
+
+    for (int sq = 0; sq < SQUARE_COUNT; ++sq) {
+        const Piece piece = state.pieceAt(sq);
+        Glyph glyph = glyphs[pieceIndex(piece)][piece == Piece::None ? 0 : state.ownerAt(sq)];
+        if (sq == cursor_sq) {
+            glyph.attrs |= A_REVERSE; // Highlight the cursor
+        } else if (reachable.test(sq)) {
+            glyph.attrs |= A_UNDERLINE; // Squares the selected piece can reach
+        }
+        if (valid && glyph == frame[sq]) {
+            continue;
+        }
+        frame[sq] = glyph;
+        attrset(glyph.attrs);
+        mvaddstr(cellRow(sq), cellColumn(sq), glyph.text);
+        ++stats.cells;
+    }
+    attrset(A_NORMAL);
+
+    // Turn, scores, the current player's hand and the status message
+    const int player = board.getPlayerTurn();
+    const Inventory& hand = board.getHand(player);
+    char text[256];
+    std::snprintf(text, sizeof(text), "Turn %d/%d. Player %d's turn.", board.getTurnCount(),
+                  board.getRules().max_turns, player);
+    drawLine(BOARD_SIZE + 2, 0, text);
+    std::snprintf(text, sizeof(text), "Score: Player 1 %d, Player 2 %d", board.getScore(1), board.getScore(2));
+    drawLine(BOARD_SIZE + 3, 1, text);
+    int length = std::snprintf(text, sizeof(text), "%-20s", "Available pieces:");
+    for (int i = 1; i < PIECE_TYPES; ++i) {
+        length += std::snprintf(text + length, sizeof(text) - length, "%c:%-4d", pieceChar(static_cast<Piece>(i)),
+                                hand[i]);
+    }
+    drawLine(BOARD_SIZE + 4, 2, text);
+    drawLine(BOARD_SIZE + 5, 3, status.c_str());
+    if (show_stats) {
+        // Opt-in: the counters change every frame, so this line always redraws.
+        std::snprintf(text, sizeof(text),
+                      "Render: %llu frames (%llu skipped), %.1f fps (max %.0f), %.1f bytes/frame, %llu over budget",
+                      static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.skipped),
+                      stats.framesPerSecond(), stats.maxFramesPerSecond(), stats.bytesPerFrame(),
+                      static_cast<unsigned long long>(stats.over_budget));
+        drawLine(BOARD_SIZE + 6, 4, text);
+    }
+
+    valid = true;
+    const std::uint64_t written = bytesWritten();
+    refresh();
+    stats.bytes += bytesWritten() - written;
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto frame_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    stats.render_time += frame_time;
+    stats.over_budget += frame_time > FRAME_BUDGET;
+    if (stats.frames++ == 0) {
+        first_frame = start;
+    }
+    last_frame = start;
+    stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(last_frame - first_frame);
+    return true;
+}
+
+void BoardView::drawLine(int row, int index, const char* text) {
+    std::string& line = lines[index];
+    if (valid && line == text) {
+        return;
+    }
+    line = text;  // reuses the line's buffer once it has grown
+    mvaddstr(row, 0, text);
+    clrtoeol();
+    ++stats.lines;
+}
@@ -1,45 +1,230 @@
 #include "game.hpp"
-#include "board.hpp"
 #include <ncurses.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/null_sink.h>
 #include <spdlog/spdlog.h>
-#include <map>
-#include <algorithm>
 #include <cctype>
+#include <climits>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+constexpr const char* LOG_PATH = "strategos.log";
+
+// Keys that select, move or place a piece for the player to move.
+bool isMoveKey(int input) {
+    if (input == ' ' || input == '\n' || input == KEY_ENTER) {
+        return true;
+    }
+    return input >= 0 && input <= UCHAR_MAX
+        && pieceFromChar(static_cast<char>(std::toupper(input))) != Piece::None;
+}
+
+} // namespace
 
 void Game::start() {
+    // ncurses owns the terminal, so the log goes to a file. Text written to
+    // stdout would stay on the board until the cells under it were redrawn.
+    try {
+        spdlog::set_default_logger(spdlog::basic_logger_mt("strategos", LOG_PATH));
+    } catch (const spdlog::spdlog_ex&) {
+        spdlog::set_default_logger(spdlog::null_logger_mt("strategos"));
+    }
     spdlog::info("Initializing game...");
     initscr();
     cbreak();
     noecho();
     keypad(stdscr, TRUE);
     curs_set(0);
+    if (has_colors()) {
+        start_color();
+        init_pair(1, COLOR_RED, COLOR_BLACK);
+        init_pair(2, COLOR_BLUE, COLOR_BLACK);
+        init_pair(3, COLOR_YELLOW, COLOR_BLACK);
+    }
+
+    // Turn order is decided randomly at the start of the game.
+    std::random_device seed;
+    board.initialize(std::uniform_int_distribution<int>(1, 2)(seed));
+    showStartScreen();
 
-    Board board;
-    board.initialize();
-
-    std::map<std::string, int> player1_pieces = {{"K", 1}, {"N", 2}, {"B", 1}, {"R", 1}};
-    std::map<std::string, int> player2_pieces = player1_pieces;
-    int player_turn = 1;
-
-    while (true) {
-        auto& current_pieces = player_turn == 1 ? player1_pieces : player2_pieces;
-        board.display(current_pieces, player_turn);
-
-        int input = getch();
-        if (std::isalpha(input)) {
-            std::string piece(1, std::toupper(input));
-            if (current_pieces[piece] > 0 && board.placePiece(piece, player_turn)) {
-                current_pieces[piece]--;
-                if (std::all_of(current_pieces.begin(), current_pieces.end(),
-                                [](const auto& pair) { return pair.second == 0; })) {
-                    player_turn = 3 - player_turn;
+    bool game_running = true;
+    int winner = 0;
+    while (game_running && !board.isGameOver(winner)) {
+        const bool computer = players[board.getPlayerTurn() - 1] == PlayerType::Computer;
+        view.display(board, cursor, valid_moves, status, !computer && isInputPending());
+        if (computer) {
+            // Read keys between the computer's moves so Q still quits when it
+            // plays itself; keys that would move for it are dropped.
+            if (isInputPending()) {
+                const int input = getch();
+                if (!isMoveKey(input)) {
+                    handleInput(input, game_running);
                 }
             }
-        } else if (input == 'q') {
-            break;
+            if (game_running) {
+                game_running = playComputerMove();
+            }
+        } else {
+            handleInput(getch(), game_running);
         }
-        board.moveCursor(input);
     }
 
+    const RenderStats& stats = view.getStats();
+    spdlog::info("Rendered {} frames ({} skipped, {} over budget): {} cells, {} lines, {} bytes ({:.1f} per frame), "
+                 "{:.1f} fps, {:.0f} fps max.", stats.frames, stats.skipped, stats.over_budget, stats.cells, stats.lines,
+                 stats.bytes, stats.bytesPerFrame(), stats.framesPerSecond(), stats.maxFramesPerSecond());
+    if (game_running) {
+        showEndScreen(winner);
+    }
     endwin();
 }
+
+void Game::handleInput(int input, bool& game_running) {
+    switch (input) {
+        case 'q':
+        case 'Q':
+            game_running = false;
+            return;
+        case ' ':
+            selectPiece();
+            return;
+        case '\n':
+        case KEY_ENTER:
+            moveSelectedPiece();
+            return;
+        case KEY_RESIZE:
+            view.invalidate();
+            return;
+    }
+
+    // Any piece letter places that piece from the hand at the cursor.
+    // ncurses key codes such as KEY_UP lie outside the unsigned char range
+    // that the <cctype> functions accept.
+    if (input >= 0 && input <= UCHAR_MAX && std::isalpha(input)) {
+        Piece piece = pieceFromChar(static_cast<char>(std::toupper(input)));
+        int player = board.getPlayerTurn();
+        if (board.placePiece(piece, cursor)) {
+            spdlog::info("Placed {} by Player {} at ({}, {}).", pieceChar(piece), player, cursor.y, cursor.x);
+            clearSelection();
+        }
+        return;
+    }
+    moveCursor(input);
+}
+
+bool Game::playComputerMove() {
+    const int player = board.getPlayerTurn();
+    if (!search) {
+        search = std::make_unique<Search>(table_megabytes);
+    }
+    SearchResult result = search->run(board, search_limits);
+    const Move& move = result.best_move;
+    if (move.to == Move::NO_SQUARE) {
+        // Only when there is no legal move, which isGameOver already ends.
+        spdlog::error("Search returned no move for Player {}.", player);
+        return false;
+    }
+    board.applyMove(move);
+    clearSelection();
+
+    // Square names are a file letter and a rank of 1 to 11.
+    char from[5] = "hand";
+    if (!move.isPlacement()) {
+        const int rank = rankOf(move.from) + 1;
+        int length = 0;
+        from[length++] = static_cast<char>('A' + fileOf(move.from));
+        if (rank >= 10) {
+            from[length++] = '1';
+        }
+        from[length++] = static_cast<char>('0' + rank % 10);
+        from[length] = '\0';
+    }
+    char buffer[200];
+    std::snprintf(buffer, sizeof(buffer),
+                  "Player %d: %c %s-%c%d (depth %d, score %d, %llu nodes, %.0f nps, %d threads, table hits %.1f%%)",
+                  player, pieceChar(move.piece), from, 'A' + fileOf(move.to), rankOf(move.to) + 1,
+                  result.depth, result.score, static_cast<unsigned long long>(result.nodes),
+                  result.nodesPerSecond(), search_limits.threads, 100.0 * result.table_stats.hitRate());
+    status = buffer;
+    spdlog::info("{}", status);
+    return true;
+}
+
+bool Game::isInputPending() const {
+    nodelay(stdscr, TRUE);
+    const int input = getch();
+    nodelay(stdscr, FALSE);
+    if (input == ERR) {
+        return false;
+    }
+    ungetch(input);
+    return true;
+}
+
+void Game::moveCursor(int input) {
+    // Handle cursor movement
+    switch (input) {
+        case KEY_UP: if (cursor.y > 0) --cursor.y; break;
+        case KEY_DOWN: if (cursor.y < BOARD_SIZE - 1) ++cursor.y; break;
+        case KEY_LEFT: if (cursor.x > 0) --cursor.x; break;
+        case KEY_RIGHT: if (cursor.x < BOARD_SIZE - 1) ++cursor.x; break;
+    }
+}
+
+void Game::selectPiece() {
+    clearSelection();
+    Bitboard targets = board.getValidTargets(cursor);
+    if (targets.empty()) {
+        return;
+    }
+    selected_pos = cursor;
+    has_selection = true;
+    while (targets.any()) {
+        int sq = targets.popLsb();
+        valid_moves.push_back({fileOf(sq), rankOf(sq)});
+    }
+}
+
+void Game::moveSelectedPiece() {
+    if (!has_selection) {
+        return;
+    }
+    Piece piece = board.getPieceAt(selected_pos);
+    int player = board.getPlayerTurn();
+    if (board.movePiece(selected_pos, cursor)) {
+        spdlog::info("Moved {} by Player {} from ({}, {}) to ({}, {}).", pieceChar(piece), player,
+                     selected_pos.y, selected_pos.x, cursor.y, cursor.x);
+    }
+    clearSelection();
+}
+
+void Game::clearSelection() {
+    selected_pos = {-1, -1};
+    has_selection = false;
+    valid_moves.clear();
+}
+
+void Game::showStartScreen() const {
+    clear();
+    mvprintw(0, 0, "Strategos");
+    mvprintw(2, 0, "Arrow keys move the cursor. S/K/N/B/R place a piece from your hand.");
+    mvprintw(3, 0, "Space selects a piece, Enter moves it to the cursor. Q quits.");
+    mvprintw(5, 0, "Player %d moves first. Press any key to start.", board.getPlayerTurn());
+    refresh();
+    getch();
+}
+
+void Game::showEndScreen(int winner) const {
+    clear();
+    if (winner == 0) {
+        mvprintw(0, 0, "The game is a draw.");
+    } else {
+        mvprintw(0, 0, "Player %d wins!", winner);
+    }
+    mvprintw(1, 0, "Score: Player 1 %d, Player 2 %d", board.getScore(1), board.getScore(2));
+    mvprintw(3, 0, "Press any key to exit.");
+    refresh();
+    getch();
+}
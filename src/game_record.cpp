@@ -0,0 +1,279 @@
+#include "game_record.hpp"
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int PIECE_BITS = 3;
+constexpr int SQUARE_BITS = 7;
+
+// Little-endian bit packer over a byte vector.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out(out) {}
+
+    void write(std::uint32_t value, int count) {
+        for (int i = 0; i < count; ++i, ++bit) {
+            if ((bit & 7) == 0) {
+                out.push_back(0);
+            }
+            out.back() |= static_cast<std::uint8_t>(((value >> i) & 1) << (bit & 7));
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& out;
+    std::size_t bit = 0;
+};
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool readVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        const std::uint8_t byte = *p++;
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The header stores the bonuses as signed bytes. Counts outside the rules'
+// limits would be recorded as given but played clamped by Board.
+bool fitsHeader(const RuleSet& rules) {
+    return rules.stones >= 0 && rules.stones <= RuleSet::MAX_STONES
+        && rules.max_turns >= 1 && rules.max_turns <= RuleSet::MAX_TURNS
+        && rules.central_bonus >= -128 && rules.central_bonus <= 127
+        && rules.capture_bonus >= -128 && rules.capture_bonus <= 127;
+}
+
+std::array<std::uint8_t, game_record::HEADER_SIZE> makeHeader(const RuleSet& rules) {
+    std::array<std::uint8_t, game_record::HEADER_SIZE> header{};
+    std::memcpy(header.data(), game_record::MAGIC, sizeof(game_record::MAGIC));
+    header[4] = game_record::VERSION;
+    header[5] = static_cast<std::uint8_t>(rules.stones);
+    header[6] = static_cast<std::uint8_t>(rules.max_turns);
+    header[7] = static_cast<std::uint8_t>(static_cast<std::int8_t>(rules.central_bonus));
+    header[8] = static_cast<std::uint8_t>(static_cast<std::int8_t>(rules.capture_bonus));
+    return header;
+}
+
+bool parseHeader(const std::uint8_t* header, RuleSet& rules) {
+    if (std::memcmp(header, game_record::MAGIC, sizeof(game_record::MAGIC)) != 0
+        || header[4] != game_record::VERSION) {
+        return false;
+    }
+    rules.stones = header[5];
+    rules.max_turns = header[6];
+    rules.central_bonus = static_cast<std::int8_t>(header[7]);
+    rules.capture_bonus = static_cast<std::int8_t>(header[8]);
+    return true;
+}
+
+// Bytes used by the packed moves of a game.
+std::size_t packedSize(const std::uint8_t* moves, std::uint32_t count, std::size_t available) {
+    // Walk the placement flags only; moves are 11 or 18 bits long.
+    std::size_t bit = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if ((bit >> 3) >= available) {
+            return available + 1;
+        }
+        const bool placement = (moves[bit >> 3] >> (bit & 7)) & 1;
+        bit += placement ? 1 + PIECE_BITS + SQUARE_BITS : 1 + PIECE_BITS + 2 * SQUARE_BITS;
+    }
+    return (bit + 7) / 8;
+}
+
+} // namespace
+
+std::uint32_t RecordedMoveReader::readBits(int count) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < count; ++i, ++bit) {
+        value |= static_cast<std::uint32_t>((data[bit >> 3] >> (bit & 7)) & 1) << i;
+    }
+    return value;
+}
+
+bool RecordedMoveReader::next(Move& move) {
+    if (remaining == 0) {
+        return false;
+    }
+    --remaining;
+    const bool placement = readBits(1);
+    move.piece = static_cast<Piece>(readBits(PIECE_BITS));
+    move.from = placement ? Move::NO_SQUARE : static_cast<std::uint8_t>(readBits(SQUARE_BITS));
+    move.to = static_cast<std::uint8_t>(readBits(SQUARE_BITS));
+    move.captured = Piece::None;
+    return true;
+}
+
+bool GameRecordWriter::open(const std::string& path, const RuleSet& rules) {
+    close();
+    if (!fitsHeader(rules)) {
+        return false;
+    }
+    file = std::fopen(path.c_str(), "a+b");
+    if (!file) {
+        return false;
+    }
+
+    const auto header = makeHeader(rules);
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        if (std::fwrite(header.data(), 1, header.size(), file) == header.size()) {
+            return true;
+        }
+    } else {
+        // Appending: the existing file must hold games played by these rules.
+        std::array<std::uint8_t, game_record::HEADER_SIZE> existing{};
+        std::rewind(file);
+        if (std::fread(existing.data(), 1, existing.size(), file) == existing.size() && existing == header) {
+            // An update stream must be repositioned between a read and a write.
+            std::fseek(file, 0, SEEK_END);
+            return true;
+        }
+    }
+    close();
+    return false;
+}
+
+void GameRecordWriter::close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool GameRecordWriter::writeGame(int first_player, int winner, std::span<const Move> moves) {
+    std::lock_guard lock(mutex);
+    if (!file) {
+        return false;
+    }
+
+    buffer.clear();
+    writeVarint(buffer, static_cast<std::uint32_t>(moves.size()));
+    buffer.push_back(static_cast<std::uint8_t>((first_player - 1) | (winner << 1)));
+    BitWriter bits(buffer);
+    for (const Move& move : moves) {
+        bits.write(move.isPlacement(), 1);
+        bits.write(static_cast<std::uint32_t>(pieceIndex(move.piece)), PIECE_BITS);
+        if (!move.isPlacement()) {
+            bits.write(move.from, SQUARE_BITS);
+        }
+        bits.write(move.to, SQUARE_BITS);
+    }
+    return std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+}
+
+bool GameRecordWriter::flush() {
+    std::lock_guard lock(mutex);
+    return file && std::fflush(file) == 0;
+}
+
+bool GameRecordReader::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < game_record::HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const std::uint8_t*>(mapping);
+    size = static_cast<std::size_t>(info.st_size);
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    if (!parseHeader(data, rules)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void GameRecordReader::close() {
+    if (data) {
+        ::munmap(const_cast<std::uint8_t*>(data), size);
+        data = nullptr;
+        size = 0;
+    }
+}
+
+bool GameRecordReader::readGame(std::size_t offset, RecordedGame& game) const {
+    if (!data || offset >= size) {
+        return false;
+    }
+    const std::uint8_t* p = data + offset;
+    const std::uint8_t* end = data + size;
+    std::uint32_t count = 0;
+    if (!readVarint(p, end, count) || p >= end) {
+        return false;
+    }
+    const std::uint8_t flags = *p++;
+    const std::size_t available = static_cast<std::size_t>(end - p);
+    const std::size_t packed = packedSize(p, count, available);
+    if (packed > available) {
+        return false;
+    }
+
+    game.offset = offset;
+    game.first_player = (flags & 1) + 1;
+    game.winner = (flags >> 1) & 3;
+    game.move_count = count;
+    game.moves = p;
+    game.size = static_cast<std::size_t>(p + packed - (data + offset));
+    return true;
+}
+
+std::vector<std::size_t> GameRecordReader::buildIndex() const {
+    std::vector<std::size_t> index;
+    RecordedGame game;
+    for (std::size_t offset = firstGame(); readGame(offset, game); offset += game.size) {
+        index.push_back(offset);
+    }
+    return index;
+}
+
+bool GameRecordReader::replay(const RecordedGame& game, Board& board) const {
+    board.initialize(game.first_player, rules);
+    RecordedMoveReader reader(game);
+    Move move;
+    while (reader.next(move)) {
+        if (move.to >= SQUARE_COUNT) {
+            return false;
+        }
+        const Position to{fileOf(move.to), rankOf(move.to)};
+        if (move.isPlacement()) {
+            if (!board.placePiece(move.piece, to)) {
+                return false;
+            }
+        } else {
+            if (move.from >= SQUARE_COUNT) {
+                return false;
+            }
+            const Position from{fileOf(move.from), rankOf(move.from)};
+            if (board.getPieceAt(from) != move.piece || !board.movePiece(from, to)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -1,8 +1,96 @@
-
 #include "game.hpp"
+#include "board.hpp"
+#include "search.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <thread>
+
+// Runs move generation from the opening position for depths 1..max_depth
+// and prints leaf counts and speed. Counts must not change between builds.
+static int runPerft(int max_depth) {
+    Board board;
+    for (int depth = 1; depth <= max_depth; ++depth) {
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t nodes = perft(board, depth);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("perft %d: %llu nodes in %.3fs (%.0f nodes/s)\n", depth,
+                    static_cast<unsigned long long>(nodes), elapsed.count(),
+                    elapsed.count() > 0 ? nodes / elapsed.count() : 0.0);
+    }
+    return 0;
+}
+
+// Searches one fixed mid-game position with 1, 2, 4, ... max_threads
+// threads and prints depth and nodes/s for each, to show how search scales.
+static int runSearchScaling(int max_threads, int move_time_ms) {
+    // Random quiet moves with both Kings kept in hand, so neither side has
+    // a forced win and the search has to use its full budget.
+    Board board;
+    std::mt19937 rng(2024);
+    for (int ply = 0; ply < 24;) {
+        MoveList moves;
+        board.generateMoves(moves);
+        const Move move = moves[rng() % moves.size()];
+        if (move.piece != Piece::King && !move.isCapture()) {
+            board.applyMove(move);
+            ++ply;
+        }
+    }
+
+    Search search;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        SearchLimits limits;
+        limits.threads = threads;
+        limits.move_time = std::chrono::milliseconds(move_time_ms);
+        search.getTable().clear();  // every run starts cold
+        SearchResult result = search.run(board, limits);
+        std::printf("threads %2d: depth %d, score %d, %llu nodes in %.3fs (%.0f nodes/s), table hits %.1f%%\n",
+                    threads, result.depth, result.score, static_cast<unsigned long long>(result.nodes),
+                    result.elapsed.count() / 1e6, result.nodesPerSecond(), 100.0 * result.table_stats.hitRate());
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "perft") {
+        return runPerft(argc > 2 ? std::atoi(argv[2]) : 3);
+    }
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (argc > 1 && std::string_view(argv[1]) == "search") {
+        return runSearchScaling(argc > 2 ? std::atoi(argv[2]) : cores, argc > 3 ? std::atoi(argv[3]) : 2000);
+    }
+
+    // --ai1 / --ai2 hand a side to the computer; --threads, --movetime
+    // (milliseconds) and --hash (transposition table megabytes) configure
+    // its search. --render-stats shows the renderer's counters.
+    std::array<PlayerType, PLAYER_COUNT> players = {PlayerType::Human, PlayerType::Human};
+    SearchLimits limits;
+    limits.threads = cores;
+    std::size_t table_megabytes = 64;
+    bool render_stats = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--ai1") {
+            players[0] = PlayerType::Computer;
+        } else if (arg == "--ai2") {
+            players[1] = PlayerType::Computer;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            limits.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--movetime" && i + 1 < argc) {
+            limits.move_time = std::chrono::milliseconds(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--hash" && i + 1 < argc) {
+            table_megabytes = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--render-stats") {
+            render_stats = true;
+        }
+    }
 
-int main() {
-    Game strategos;
+    Game strategos(players, limits, table_megabytes);
+    strategos.setShowRenderStats(render_stats);
     strategos.start();
     return 0;
 }
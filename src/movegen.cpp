@@ -0,0 +1,73 @@
+#include "movegen.hpp"
+#include "attacks.hpp"
+
+namespace {
+
+constexpr Piece MOVABLE_PIECES[] = {Piece::King, Piece::Knight, Piece::Bishop, Piece::Rook};
+
+Bitboard blockedSquares(const BoardState& state, int player) {
+    return state.occupancy(player) | state.pieces(1, Piece::Stone) | state.pieces(2, Piece::Stone);
+}
+
+} // namespace
+
+Bitboard legalTargets(const BoardState& state, int sq) {
+    int player = state.ownerAt(sq);
+    if (player == 0) {
+        return Bitboard{};
+    }
+    return attacksFrom(state.pieceAt(sq), sq, state.occupancy()) & ~blockedSquares(state, player);
+}
+
+void generatePieceMoves(const BoardState& state, int player, Piece piece, MoveList& moves) {
+    const Bitboard occupied = state.occupancy();
+    const Bitboard allowed = ~blockedSquares(state, player);
+    Bitboard from_set = state.pieces(player, piece);
+    while (from_set.any()) {
+        int from = from_set.popLsb();
+        Bitboard targets = attacksFrom(piece, from, occupied) & allowed;
+        while (targets.any()) {
+            int to = targets.popLsb();
+            moves.push({static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to),
+                        piece, state.pieceAt(to)});
+        }
+    }
+}
+
+void generatePlacements(const BoardState& state, const Inventory& hand, MoveList& moves) {
+    const Bitboard empty = ~state.occupancy();
+    for (int i = 1; i < PIECE_TYPES; ++i) {
+        if (hand[i] == 0) continue;
+        Bitboard targets = empty;
+        while (targets.any()) {
+            int to = targets.popLsb();
+            moves.push({Move::NO_SQUARE, static_cast<std::uint8_t>(to), static_cast<Piece>(i), Piece::None});
+        }
+    }
+}
+
+void generateMoves(const BoardState& state, const Inventory& hand, int player, MoveList& moves) {
+    generatePlacements(state, hand, moves);
+    for (Piece piece : MOVABLE_PIECES) {
+        generatePieceMoves(state, player, piece, moves);
+    }
+}
+
+bool hasMoves(const BoardState& state, const Inventory& hand, int player) {
+    const Bitboard occupied = state.occupancy();
+    if ((~occupied).any()) {
+        for (int i = 1; i < PIECE_TYPES; ++i) {
+            if (hand[i] != 0) return true;
+        }
+    }
+    const Bitboard allowed = ~blockedSquares(state, player);
+    for (Piece piece : MOVABLE_PIECES) {
+        Bitboard from_set = state.pieces(player, piece);
+        while (from_set.any()) {
+            if ((attacksFrom(piece, from_set.popLsb(), occupied) & allowed).any()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,415 @@
+#include "search.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int INF_SCORE = Search::WIN_SCORE + 1;
+constexpr int MAX_PLY = 64;
+constexpr std::uint64_t TIME_CHECK_MASK = 1023;
+
+// Rough material values, used only to order captures.
+constexpr int PIECE_VALUES[PIECE_TYPES] = {0, 0, 1000, 30, 35, 50};  // None, S, K, N, B, R
+
+constexpr Move NO_MOVE{Move::NO_SQUARE, Move::NO_SQUARE, Piece::None, Piece::None};
+
+// Win scores are stored relative to the node, not the root, so a stored
+// forced win stays correct when reached at a different ply.
+int toTable(int score, int ply) {
+    if (score >= Search::WIN_SCORE - MAX_PLY) return score + ply;
+    if (score <= -Search::WIN_SCORE + MAX_PLY) return score - ply;
+    return score;
+}
+
+int fromTable(int score, int ply) {
+    if (score >= Search::WIN_SCORE - MAX_PLY) return score - ply;
+    if (score <= -Search::WIN_SCORE + MAX_PLY) return score + ply;
+    return score;
+}
+
+struct ScoredMove {
+    Move move;
+    int score;
+};
+
+int centrality(int sq) {
+    const int centre = BOARD_SIZE / 2;
+    return 2 * centre - std::abs(fileOf(sq) - centre) - std::abs(rankOf(sq) - centre);
+}
+
+// The deepest answer any thread has found. A completed iteration beats a
+// cut-short one of the same depth.
+class SharedResult {
+public:
+    explicit SharedResult(const Move& first_move) : best_move(first_move) {}
+
+    void report(int depth, bool complete, const Move& move, int score) {
+        std::lock_guard lock(mutex);
+        if (depth <= completed_depth || (complete ? depth < partial_depth : depth <= partial_depth)) {
+            return;
+        }
+        if (complete) {
+            completed_depth = depth;
+        } else {
+            partial_depth = depth;
+        }
+        best_move = move;
+        best_score = score;
+    }
+
+    void read(SearchResult& result) const {
+        std::lock_guard lock(mutex);
+        result.best_move = best_move;
+        result.score = best_score;
+        result.depth = completed_depth;
+    }
+
+private:
+    mutable std::mutex mutex;
+    int completed_depth = 0;
+    int partial_depth = 0;
+    Move best_move;
+    int best_score = 0;
+};
+
+// One search thread: its own copy of the board and its own move-ordering
+// state, so threads only share the stop flag, the table and the result.
+class Worker {
+public:
+    Worker(const Board& root, TranspositionTable& table, std::atomic<bool>& stopped, Clock::time_point deadline)
+        : board(root), table(table), stopped(stopped), deadline(deadline) {}
+
+    std::uint64_t nodes = 0;
+    TranspositionTable::Stats table_stats;
+
+    int searchRootMove(const Move& move, int depth, int alpha, int beta) {
+        board.applyMove(move);
+        int score = -negamax(depth - 1, -beta, -alpha, 1);
+        board.undoMove(move);
+        return score;
+    }
+
+    bool isStopped() const { return stopped.load(std::memory_order_relaxed); }
+
+    // Iterative deepening over 'root_moves' (best first) until the depth
+    // limit, a forced result or the stop flag, reporting each iteration.
+    void iterate(std::vector<Move> root_moves, int first_depth, int max_depth, SharedResult& shared) {
+        for (int depth = first_depth; depth <= max_depth; ++depth) {
+            int alpha = -INF_SCORE;
+            int best_score = -INF_SCORE;
+            Move best_move = root_moves.front();
+            for (std::size_t i = 0; i < root_moves.size(); ++i) {
+                const Move& move = root_moves[i];
+                int score;
+                if (i == 0) {
+                    score = searchRootMove(move, depth, -INF_SCORE, INF_SCORE);
+                } else {
+                    score = searchRootMove(move, depth, alpha, alpha + 1);
+                    if (score > alpha && !isStopped()) {
+                        score = searchRootMove(move, depth, alpha, INF_SCORE);
+                    }
+                }
+                if (isStopped()) {
+                    break;
+                }
+                if (score > best_score) {
+                    best_score = score;
+                    best_move = move;
+                    alpha = std::max(alpha, score);
+                }
+            }
+
+            if (isStopped()) {
+                // A move that beat the first one was fully searched, so it is
+                // usable even though the iteration was cut short.
+                if (!(best_move == root_moves.front())) {
+                    shared.report(depth, false, best_move, best_score);
+                }
+                return;
+            }
+            shared.report(depth, true, best_move, best_score);
+            auto best_it = std::find(root_moves.begin(), root_moves.end(), best_move);
+            std::rotate(root_moves.begin(), best_it, best_it + 1);
+            if (std::abs(best_score) >= Search::WIN_SCORE - MAX_PLY) {
+                return;  // forced result found
+            }
+        }
+    }
+
+    std::size_t orderMoves(const MoveList& moves, std::array<ScoredMove, MoveList::CAPACITY>& scored, int ply,
+                           const Move& table_move = NO_MOVE) const {
+        const auto& killer = killers[std::min(ply, MAX_PLY - 1)];
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            const Move& move = moves[i];
+            int score = centrality(move.to);
+            if (move == table_move) {
+                score += 2'000'000;
+            } else if (move.isCapture()) {
+                score += 1'000'000 + 10 * PIECE_VALUES[pieceIndex(move.captured)] - PIECE_VALUES[pieceIndex(move.piece)];
+            } else if (move == killer[0]) {
+                score += 900'000;
+            } else if (move == killer[1]) {
+                score += 800'000;
+            } else if (!move.isPlacement()) {
+                score += 100;  // developing a piece on the board beats a new drop
+            }
+            scored[i] = {move, score};
+        }
+        std::sort(scored.begin(), scored.begin() + moves.size(),
+                  [](const ScoredMove& a, const ScoredMove& b) { return a.score > b.score; });
+        return moves.size();
+    }
+
+private:
+    Board board;
+    TranspositionTable& table;
+    std::atomic<bool>& stopped;
+    Clock::time_point deadline;
+    std::array<std::array<Move, 2>, MAX_PLY> killers{};
+
+    bool checkTime() {
+        if ((++nodes & TIME_CHECK_MASK) == 0 && Clock::now() >= deadline) {
+            stopped.store(true, std::memory_order_relaxed);
+        }
+        return isStopped();
+    }
+
+    int evaluate() const {
+        const int player = board.getPlayerTurn();
+        return board.getScore(player) - board.getScore(3 - player);
+    }
+
+    // Score of a finished game for the player to move, preferring quick wins.
+    int terminalScore(int winner, int ply) const {
+        if (winner == 0) {
+            return 0;
+        }
+        return winner == board.getPlayerTurn() ? Search::WIN_SCORE - ply : -Search::WIN_SCORE + ply;
+    }
+
+    void storeKiller(const Move& move, int ply) {
+        auto& killer = killers[std::min(ply, MAX_PLY - 1)];
+        if (move.isCapture() || move == killer[0]) {
+            return;
+        }
+        killer[1] = killer[0];
+        killer[0] = move;
+    }
+
+    int negamax(int depth, int alpha, int beta, int ply) {
+        if (depth <= 0 || ply >= MAX_PLY - 1) {
+            return quiescence(alpha, beta, ply);
+        }
+        if (checkTime()) {
+            return 0;
+        }
+        int winner = 0;
+        if (board.isGameOver(winner)) {
+            return terminalScore(winner, ply);
+        }
+
+        const std::uint64_t key = board.getHash();
+        Move table_move = NO_MOVE;
+        TranspositionTable::Entry entry;
+        ++table_stats.probes;
+        if (table.probe(key, entry)) {
+            ++table_stats.hits;
+            table_move = entry.move;
+            const int score = fromTable(entry.score, ply);
+            if (entry.depth >= depth) {
+                using Bound = TranspositionTable::Bound;
+                if (entry.bound == Bound::Exact
+                    || (entry.bound == Bound::Lower && score >= beta)
+                    || (entry.bound == Bound::Upper && score <= alpha)) {
+                    return score;
+                }
+            }
+        }
+
+        MoveList moves;
+        board.generateMoves(moves);  // not empty: isGameOver covers having no move
+        std::array<ScoredMove, MoveList::CAPACITY> scored;
+        const std::size_t count = orderMoves(moves, scored, ply, table_move);
+
+        const int original_alpha = alpha;
+        int best = -INF_SCORE;
+        Move best_move = scored[0].move;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Move& move = scored[i].move;
+            board.applyMove(move);
+            int score = -negamax(depth - 1, -beta, -alpha, ply + 1);
+            board.undoMove(move);
+            if (isStopped()) {
+                return 0;
+            }
+            if (score > best) {
+                best = score;
+                best_move = move;
+                if (score > alpha) {
+                    alpha = score;
+                    if (alpha >= beta) {
+                        storeKiller(move, ply);
+                        break;
+                    }
+                }
+            }
+        }
+
+        using Bound = TranspositionTable::Bound;
+        const Bound bound = best >= beta ? Bound::Lower : (best <= original_alpha ? Bound::Upper : Bound::Exact);
+        table.store(key, best_move, toTable(best, ply), depth, bound);
+        ++table_stats.stores;
+        return best;
+    }
+
+    // Resolves pending captures so the horizon does not hide a lost piece.
+    int quiescence(int alpha, int beta, int ply) {
+        if (checkTime()) {
+            return 0;
+        }
+        int winner = 0;
+        if (board.isGameOver(winner)) {
+            return terminalScore(winner, ply);
+        }
+        int stand_pat = evaluate();
+        if (stand_pat >= beta || ply >= MAX_PLY - 1) {
+            return stand_pat;
+        }
+        alpha = std::max(alpha, stand_pat);
+
+        MoveList moves;
+        const int player = board.getPlayerTurn();
+        for (Piece piece : {Piece::King, Piece::Knight, Piece::Bishop, Piece::Rook}) {
+            generatePieceMoves(board.getState(), player, piece, moves);
+        }
+
+        int best = stand_pat;
+        for (const Move& move : moves) {
+            if (!move.isCapture()) {
+                continue;
+            }
+            board.applyMove(move);
+            int score = -quiescence(-beta, -alpha, ply + 1);
+            board.undoMove(move);
+            if (isStopped()) {
+                return 0;
+            }
+            if (score > best) {
+                best = score;
+                if (score > alpha) {
+                    alpha = score;
+                    if (alpha >= beta) {
+                        break;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+};
+
+} // namespace
+
+SearchResult Search::run(const Board& board, const SearchLimits& limits) {
+    const auto start = Clock::now();
+    const auto deadline = start + limits.move_time;
+    stopped.store(false, std::memory_order_relaxed);
+    table.newSearch();
+
+    const int thread_count = std::max(1, limits.threads);
+    if (static_cast<int>(helpers.size()) != thread_count - 1) {
+        stopHelpers();
+        startHelpers(thread_count - 1);
+    }
+    std::vector<Worker> workers;
+    workers.reserve(thread_count);
+    for (int i = 0; i < thread_count; ++i) {
+        workers.emplace_back(board, table, stopped, deadline);
+    }
+
+    MoveList moves;
+    board.generateMoves(moves);
+    std::vector<Move> root_moves;
+    {
+        std::array<ScoredMove, MoveList::CAPACITY> scored;
+        const std::size_t count = workers[0].orderMoves(moves, scored, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            root_moves.push_back(scored[i].move);
+        }
+    }
+
+    SearchResult result;
+    if (root_moves.empty()) {
+        return result;
+    }
+
+    SharedResult shared(root_moves.front());
+    const std::function<void(int)> job = [&](int index) {
+        // Odd helpers run one ply ahead so the threads spread over depths.
+        workers[index].iterate(root_moves, 1 + (index & 1), limits.max_depth, shared);
+        if (index == 0) {
+            stop();  // the main thread's deadline or depth limit ends the search
+        }
+    };
+    runOnAllThreads(job);
+    shared.read(result);
+
+    for (const Worker& worker : workers) {
+        result.nodes += worker.nodes;
+        result.table_stats.probes += worker.table_stats.probes;
+        result.table_stats.hits += worker.table_stats.hits;
+        result.table_stats.stores += worker.table_stats.stores;
+    }
+    table.addStats(result.table_stats);
+    result.hashfull = table.hashfull();
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    return result;
+}
+
+void Search::startHelpers(int count) {
+    // Read here rather than in the thread, which could start after the next
+    // job was posted and then never run it.
+    const std::uint64_t last_job = job_id;
+    for (int i = 1; i <= count; ++i) {
+        helpers.emplace_back([this, i, last_job](std::stop_token stop) { helperLoop(stop, i, last_job); });
+    }
+}
+
+void Search::stopHelpers() {
+    helpers.clear();  // each jthread is asked to stop and joined
+}
+
+void Search::helperLoop(std::stop_token stop, int index, std::uint64_t done_id) {
+    std::unique_lock lock(pool_mutex);
+    while (work_ready.wait(lock, stop, [&] { return job_id != done_id; })) {
+        done_id = job_id;
+        const std::function<void(int)>& current = *job;
+        lock.unlock();
+        current(index);
+        lock.lock();
+        if (--running == 0) {
+            work_done.notify_all();
+        }
+    }
+}
+
+void Search::runOnAllThreads(const std::function<void(int)>& work) {
+    {
+        std::lock_guard lock(pool_mutex);
+        job = &work;
+        running = static_cast<int>(helpers.size());
+        ++job_id;
+    }
+    work_ready.notify_all();
+    work(0);
+    std::unique_lock lock(pool_mutex);
+    work_done.wait(lock, [&] { return running == 0; });
+    job = nullptr;
+}
@@ -0,0 +1,89 @@
+#include "territory.hpp"
+#include "attacks.hpp"
+
+namespace {
+
+constexpr int CENTRAL_SIZE = 5;
+
+constexpr Bitboard makeCentralRegion() {
+    constexpr int start = (BOARD_SIZE - CENTRAL_SIZE) / 2;
+    Bitboard region;
+    for (int y = start; y < start + CENTRAL_SIZE; ++y) {
+        for (int x = start; x < start + CENTRAL_SIZE; ++x) {
+            region.set(squareOf(x, y));
+        }
+    }
+    return region;
+}
+
+constexpr Bitboard CENTRAL_REGION = makeCentralRegion();
+
+} // namespace
+
+void Territory::adjust(int player, const Bitboard& squares, int delta) {
+    Bitboard rest = squares;
+    while (rest.any()) {
+        const int sq = rest.popLsb();
+        const int before = controller(sq);
+        influence[player - 1][sq] = static_cast<std::uint8_t>(influence[player - 1][sq] + delta);
+        const int after = controller(sq);
+        if (before == after) {
+            continue;
+        }
+        const int in_centre = CENTRAL_REGION.test(sq);
+        if (before != 0) {
+            --territory[before - 1];
+            central[before - 1] -= in_centre;
+        }
+        if (after != 0) {
+            ++territory[after - 1];
+            central[after - 1] += in_centre;
+        }
+    }
+}
+
+void Territory::refresh(const BoardState& state, int sq) {
+    if (held_by[sq] != 0) {
+        adjust(held_by[sq], held[sq], -1);
+    }
+    const int owner = state.ownerAt(sq);
+    held_by[sq] = static_cast<std::uint8_t>(owner);
+    held[sq] = owner != 0 ? controlFrom(state.pieceAt(sq), sq, state.occupancy()) : Bitboard{};
+    if (owner != 0) {
+        adjust(owner, held[sq], +1);
+    }
+}
+
+void Territory::update(const BoardState& state, const Bitboard& changed) {
+    // A slider's lines can only grow or shrink at a changed square it held
+    // before; pieces that arrived on a changed square are covered by it.
+    Bitboard affected = changed;
+    Bitboard sliders;
+    for (int player = 1; player <= PLAYER_COUNT; ++player) {
+        sliders |= state.pieces(player, Piece::Bishop) | state.pieces(player, Piece::Rook);
+    }
+    while (sliders.any()) {
+        const int sq = sliders.popLsb();
+        if ((held[sq] & changed).any()) {
+            affected.set(sq);
+        }
+    }
+
+    while (affected.any()) {
+        refresh(state, affected.popLsb());
+    }
+}
+
+void Territory::recompute(const BoardState& state) {
+    clear();
+    Bitboard occupied = state.occupancy();
+    while (occupied.any()) {
+        refresh(state, occupied.popLsb());
+    }
+}
+
+bool Territory::matchesRecompute(const BoardState& state) const {
+    Territory fresh;
+    fresh.recompute(state);
+    return fresh == *this;
+}
@@ -0,0 +1,127 @@
+#include "transposition_table.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr int FROM_SHIFT = 0;
+constexpr int TO_SHIFT = 8;
+constexpr int PIECE_SHIFT = 16;
+constexpr int CAPTURED_SHIFT = 19;
+constexpr int SCORE_SHIFT = 22;
+constexpr int DEPTH_SHIFT = 38;
+constexpr int BOUND_SHIFT = 46;
+constexpr int GENERATION_SHIFT = 48;
+
+std::uint64_t field(std::uint64_t data, int shift, int bits) {
+    return (data >> shift) & ((std::uint64_t{1} << bits) - 1);
+}
+
+} // namespace
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    cluster_count = std::max<std::size_t>(1, megabytes * 1024 * 1024 / sizeof(Cluster));
+    clusters = std::make_unique<Cluster[]>(cluster_count);
+    generation = 0;
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i < cluster_count; ++i) {
+        for (Slot& slot : clusters[i].slots) {
+            slot.key_xor_data.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+    total_probes = 0;
+    total_hits = 0;
+    total_stores = 0;
+}
+
+std::uint64_t TranspositionTable::pack(const Move& move, int score, int depth, Bound bound, std::uint8_t gen) {
+    return std::uint64_t{move.from} << FROM_SHIFT
+         | std::uint64_t{move.to} << TO_SHIFT
+         | std::uint64_t(pieceIndex(move.piece)) << PIECE_SHIFT
+         | std::uint64_t(pieceIndex(move.captured)) << CAPTURED_SHIFT
+         | std::uint64_t(static_cast<std::uint16_t>(score)) << SCORE_SHIFT
+         | std::uint64_t(static_cast<std::uint8_t>(std::clamp(depth, 0, 255))) << DEPTH_SHIFT
+         | std::uint64_t(static_cast<std::uint8_t>(bound)) << BOUND_SHIFT
+         | std::uint64_t{gen} << GENERATION_SHIFT;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(std::uint64_t data) {
+    Entry entry;
+    entry.move = {static_cast<std::uint8_t>(field(data, FROM_SHIFT, 8)),
+                  static_cast<std::uint8_t>(field(data, TO_SHIFT, 8)),
+                  static_cast<Piece>(field(data, PIECE_SHIFT, 3)),
+                  static_cast<Piece>(field(data, CAPTURED_SHIFT, 3))};
+    entry.score = static_cast<std::int16_t>(field(data, SCORE_SHIFT, 16));
+    entry.depth = static_cast<int>(field(data, DEPTH_SHIFT, 8));
+    entry.bound = static_cast<Bound>(field(data, BOUND_SHIFT, 2));
+    return entry;
+}
+
+TranspositionTable::Cluster& TranspositionTable::clusterFor(std::uint64_t key) const {
+    // Maps the key onto [0, cluster_count) without needing a power of two.
+    return clusters[static_cast<std::size_t>((static_cast<unsigned __int128>(key) * cluster_count) >> 64)];
+}
+
+bool TranspositionTable::probe(std::uint64_t key, Entry& entry) const {
+    for (const Slot& slot : clusterFor(key).slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data != 0 && (slot.key_xor_data.load(std::memory_order_relaxed) ^ data) == key) {
+            entry = unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, const Move& move, int score, int depth, Bound bound) {
+    Cluster& cluster = clusterFor(key);
+
+    // Reuse this key's slot, else an empty one, else the shallowest and
+    // oldest entry.
+    Slot* target = nullptr;
+    int worst = 0;
+    for (Slot& slot : cluster.slots) {
+        const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if (data == 0 || (slot.key_xor_data.load(std::memory_order_relaxed) ^ data) == key) {
+            target = &slot;
+            break;
+        }
+        const int age = static_cast<std::uint8_t>(generation - field(data, GENERATION_SHIFT, 8));
+        const int value = static_cast<int>(field(data, DEPTH_SHIFT, 8)) - 8 * age;
+        if (!target || value < worst) {
+            target = &slot;
+            worst = value;
+        }
+    }
+
+    const std::uint64_t data = pack(move, score, depth, bound, generation);
+    target->key_xor_data.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    const std::size_t sample = std::min<std::size_t>(cluster_count, 250);
+    int used = 0;
+    for (std::size_t i = 0; i < sample; ++i) {
+        for (const Slot& slot : clusters[i].slots) {
+            const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+            used += data != 0 && field(data, GENERATION_SHIFT, 8) == generation;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sample * CLUSTER_SIZE));
+}
+
+void TranspositionTable::addStats(const Stats& local) {
+    total_probes.fetch_add(local.probes, std::memory_order_relaxed);
+    total_hits.fetch_add(local.hits, std::memory_order_relaxed);
+    total_stores.fetch_add(local.stores, std::memory_order_relaxed);
+}
+
+TranspositionTable::Stats TranspositionTable::stats() const {
+    return {total_probes.load(std::memory_order_relaxed),
+            total_hits.load(std::memory_order_relaxed),
+            total_stores.load(std::memory_order_relaxed)};
+}
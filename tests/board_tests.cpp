@@ -0,0 +1,41 @@
+#include "board.hpp"
+#include "test.hpp"
+#include <random>
+
+// Out-of-range rules are clamped, so the hand and turn counts stay inside
+// the Zobrist tables for a whole game.
+TEST(rules_clamped) {
+    RuleSet rules;
+    rules.stones = 40;
+    rules.max_turns = 500;
+    Board board;
+    board.initialize(2, rules);
+    CHECK(board.getRules().stones == RuleSet::MAX_STONES);
+    CHECK(board.getRules().max_turns == RuleSet::MAX_TURNS);
+    CHECK(board.getHand(1)[pieceIndex(Piece::Stone)] == RuleSet::MAX_STONES);
+
+    rules.stones = -3;
+    rules.max_turns = 0;
+    board.initialize(1, rules);
+    CHECK(board.getRules().stones == 0);
+    CHECK(board.getRules().max_turns == 1);
+
+    // No captures, so no King is lost and the game runs to the turn limit
+    // with the incremental hash intact.
+    rules.stones = 100;
+    rules.max_turns = 100;
+    board.initialize(1, rules);
+    std::mt19937_64 rng(3);
+    int winner = 0;
+    while (!board.isGameOver(winner)) {
+        MoveList moves;
+        board.generateMoves(moves);
+        Move move = moves[rng() % moves.size()];
+        for (int tries = 0; tries < 100 && move.isCapture(); ++tries) {
+            move = moves[rng() % moves.size()];
+        }
+        board.applyMove(move);
+        CHECK(board.getHash() == board.computeHash());
+    }
+    CHECK(board.getTurnCount() == RuleSet::MAX_TURNS + 1);
+}
@@ -0,0 +1,130 @@
+#include "game_record.hpp"
+#include "test.hpp"
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct PlayedGame {
+    int first_player;
+    int winner;
+    std::vector<Move> moves;
+};
+
+// Random games to the end, with the rules' own winner.
+std::vector<PlayedGame> playGames(int count, const RuleSet& rules, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<PlayedGame> games;
+    for (int i = 0; i < count; ++i) {
+        PlayedGame game{1 + static_cast<int>(rng() % 2), 0, {}};
+        Board board;
+        board.initialize(game.first_player, rules);
+        MoveList moves;
+        while (!board.isGameOver(game.winner)) {
+            moves.clear();
+            board.generateMoves(moves);
+            const Move move = moves[rng() % moves.size()];
+            board.applyMove(move);
+            game.moves.push_back(move);
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+std::string tempPath(const char* name) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+bool writeGames(const std::string& path, const RuleSet& rules, const std::vector<PlayedGame>& games) {
+    GameRecordWriter writer;
+    if (!writer.open(path, rules)) {
+        return false;
+    }
+    for (const PlayedGame& game : games) {
+        if (!writer.writeGame(game.first_player, game.winner, game.moves)) {
+            return false;
+        }
+    }
+    return writer.flush();
+}
+
+} // namespace
+
+TEST(record_round_trip) {
+    RuleSet rules;
+    rules.stones = 6;
+    rules.capture_bonus = -2;
+    const std::vector<PlayedGame> games = playGames(300, rules, 7);
+    const std::string path = tempPath("strategos_record_round_trip.rec");
+    // Written in two sessions to cover appending to an existing file.
+    const std::vector<PlayedGame> first(games.begin(), games.begin() + 100);
+    const std::vector<PlayedGame> second(games.begin() + 100, games.end());
+    CHECK(writeGames(path, rules, first));
+    CHECK(writeGames(path, rules, second));
+
+    GameRecordReader reader;
+    CHECK(reader.open(path));
+    CHECK(reader.getRules().stones == rules.stones);
+    CHECK(reader.getRules().capture_bonus == rules.capture_bonus);
+    const std::vector<std::size_t> index = reader.buildIndex();
+    CHECK(index.size() == games.size());
+    for (std::size_t i = 0; i < index.size() && i < games.size(); ++i) {
+        RecordedGame recorded;
+        CHECK(reader.readGame(index[i], recorded));
+        CHECK(recorded.first_player == games[i].first_player);
+        CHECK(recorded.winner == games[i].winner);
+        CHECK(recorded.move_count == games[i].moves.size());
+
+        Board board;
+        CHECK(reader.replay(recorded, board));
+        int winner = -1;
+        CHECK(board.isGameOver(winner));
+        CHECK(winner == games[i].winner);
+    }
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+TEST(record_truncated) {
+    const RuleSet rules;
+    const std::vector<PlayedGame> games = playGames(20, rules, 11);
+    const std::string path = tempPath("strategos_record_truncated.rec");
+    CHECK(writeGames(path, rules, games));
+
+    // Cut the last game short: every complete game still reads, the cut one
+    // does not.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    GameRecordReader reader;
+    CHECK(reader.open(path));
+    const std::vector<std::size_t> index = reader.buildIndex();
+    CHECK(index.size() == games.size() - 1);
+    RecordedGame game;
+    CHECK(reader.readGame(index.back(), game));
+    CHECK(!reader.readGame(index.back() + game.size, game));
+    reader.close();
+
+    // A file shorter than its header does not open.
+    std::filesystem::resize_file(path, game_record::HEADER_SIZE - 1);
+    CHECK(!reader.open(path));
+    std::filesystem::remove(path);
+}
+
+TEST(record_rules_checked) {
+    const std::string path = tempPath("strategos_record_rules.rec");
+    RuleSet rules;
+    CHECK(writeGames(path, rules, {}));
+
+    GameRecordWriter writer;
+    rules.central_bonus = 2;
+    CHECK(!writer.open(path, rules));  // recorded with other rules
+    std::filesystem::remove(path);
+
+    rules.capture_bonus = 200;  // does not fit the header
+    CHECK(!writer.open(path, rules));
+    CHECK(!std::filesystem::exists(path));
+}
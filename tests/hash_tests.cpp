@@ -0,0 +1,111 @@
+#include "board.hpp"
+#include "search.hpp"
+#include "test.hpp"
+#include "transposition_table.hpp"
+#include <random>
+
+// The same Stones placed in a different order give the same key.
+TEST(hash_transpositions) {
+    Board a;
+    Board b;
+    const Position first[] = {{0, 0}, {10, 10}, {1, 0}, {10, 9}};
+    const Position second[] = {{1, 0}, {10, 9}, {0, 0}, {10, 10}};
+    for (int i = 0; i < 4; ++i) {
+        CHECK(a.placePiece(Piece::Stone, first[i]));
+        CHECK(b.placePiece(Piece::Stone, second[i]));
+    }
+    CHECK(a.getHash() == b.getHash());
+    CHECK(a.getHash() == a.computeHash());
+
+    // A different square for one Stone is a different position.
+    Board c;
+    const Position third[] = {{0, 0}, {10, 10}, {2, 0}, {10, 9}};
+    for (const Position& pos : third) {
+        CHECK(c.placePiece(Piece::Stone, pos));
+    }
+    CHECK(c.getHash() != a.getHash());
+}
+
+// The incremental key must match a full computation through captures,
+// which change both the board and the capture counts, and undo exactly.
+TEST(hash_captures) {
+    std::mt19937_64 rng(17);
+    int captures = 0;
+    for (int game = 0; game < 200; ++game) {
+        Board board;
+        board.initialize(1 + game % 2);
+        int winner = 0;
+        while (!board.isGameOver(winner)) {
+            MoveList moves;
+            board.generateMoves(moves);
+            Move move = moves[rng() % moves.size()];
+            for (const Move& candidate : moves) {
+                if (candidate.isCapture() && rng() % 2) {
+                    move = candidate;
+                    break;
+                }
+            }
+            captures += move.isCapture();
+
+            const std::uint64_t before = board.getHash();
+            board.applyMove(move);
+            CHECK(board.getHash() == board.computeHash());
+            board.undoMove(move);
+            CHECK(board.getHash() == before);
+            board.applyMove(move);
+        }
+    }
+    CHECK(captures > 100);
+}
+
+TEST(table_store_probe) {
+    TranspositionTable table(1);
+    using Bound = TranspositionTable::Bound;
+    TranspositionTable::Entry entry;
+    const Move placement{Move::NO_SQUARE, 60, Piece::Stone, Piece::None};
+    const Move capture{12, 34, Piece::Rook, Piece::Knight};
+
+    CHECK(!table.probe(0x1234, entry));
+    table.store(0x1234, capture, 250, 7, Bound::Lower);
+    CHECK(table.probe(0x1234, entry));
+    CHECK(entry.move == capture);
+    CHECK(entry.score == 250);
+    CHECK(entry.depth == 7);
+    CHECK(entry.bound == Bound::Lower);
+
+    // Negative scores come back through the 16-bit field with their sign.
+    for (int score : {-1, -250, -Search::WIN_SCORE}) {
+        table.store(0xBEEF, placement, score, 3, Bound::Upper);
+        CHECK(table.probe(0xBEEF, entry));
+        CHECK(entry.score == score);
+        CHECK(entry.move == placement);
+    }
+
+    // Storing the same key again replaces the entry rather than adding one.
+    table.store(0x1234, placement, -5, 2, Bound::Exact);
+    CHECK(table.probe(0x1234, entry));
+    CHECK(entry.move == placement);
+    CHECK(entry.score == -5);
+    CHECK(entry.depth == 2);
+    CHECK(entry.bound == Bound::Exact);
+    CHECK(table.hashfull() >= 0);
+
+    table.clear();
+    CHECK(!table.probe(0x1234, entry));
+}
+
+TEST(table_stats) {
+    CHECK(TranspositionTable::Stats{}.hitRate() == 0.0);
+    CHECK((TranspositionTable::Stats{10, 4, 0}.hitRate() == 0.4));
+
+    TranspositionTable table(1);
+    table.addStats({10, 4, 6});
+    table.addStats({30, 6, 1});
+    const TranspositionTable::Stats total = table.stats();
+    CHECK(total.probes == 40);
+    CHECK(total.hits == 10);
+    CHECK(total.stores == 7);
+    CHECK(total.hitRate() == 0.25);
+    table.clear();
+    CHECK(table.stats().probes == 0);
+}
@@ -0,0 +1,73 @@
+#include "attacks.hpp"
+#include "board.hpp"
+#include "test.hpp"
+#include <random>
+
+namespace {
+
+// Walks each ray square by square, stopping after the first occupied one.
+Bitboard walkRays(int sq, const Bitboard& occupied, const int (*directions)[2]) {
+    Bitboard attacks;
+    for (int d = 0; d < 4; ++d) {
+        int x = fileOf(sq) + directions[d][0];
+        int y = rankOf(sq) + directions[d][1];
+        while (x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE) {
+            attacks.set(squareOf(x, y));
+            if (occupied.test(squareOf(x, y))) {
+                break;
+            }
+            x += directions[d][0];
+            y += directions[d][1];
+        }
+    }
+    return attacks;
+}
+
+constexpr int ORTHOGONAL[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+constexpr int DIAGONAL[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+} // namespace
+
+// Node counts from the opening position; any change to move generation or
+// the end-of-game rules that alters them is a regression.
+TEST(perft) {
+    Board board;
+    CHECK(perft(board, 1) == 605);
+    CHECK(perft(board, 2) == 363000);
+    CHECK(perft(board, 3) == 193320480);
+}
+
+TEST(slider_attacks) {
+    std::mt19937_64 rng(2024);
+    for (int i = 0; i < 20000; ++i) {
+        // Sparse to dense boards, so long and short rays both get covered.
+        Bitboard occupied{rng() & rng(), rng() & rng() & Bitboard::HI_MASK};
+        if (i % 2) {
+            occupied = occupied | Bitboard{rng(), rng() & Bitboard::HI_MASK};
+        }
+        const int sq = static_cast<int>(rng() % SQUARE_COUNT);
+        CHECK(rookAttacks(sq, occupied) == walkRays(sq, occupied, ORTHOGONAL));
+        CHECK(bishopAttacks(sq, occupied) == walkRays(sq, occupied, DIAGONAL));
+    }
+}
+
+TEST(has_moves) {
+    // A lone Knight in the corner, both of its squares taken by Stones,
+    // which can never be captured.
+    BoardState state;
+    state.put(squareOf(0, 0), Piece::Knight, 1);
+    state.put(squareOf(1, 2), Piece::Stone, 2);
+    state.put(squareOf(2, 1), Piece::Stone, 1);
+    CHECK(!hasMoves(state, Inventory{}, 1));
+
+    Inventory hand{};
+    hand[pieceIndex(Piece::Rook)] = 1;
+    CHECK(hasMoves(state, hand, 1));  // can still place
+
+    state.remove(squareOf(2, 1));
+    CHECK(hasMoves(state, Inventory{}, 1));
+
+    MoveList moves;
+    generateMoves(state, Inventory{}, 2, moves);
+    CHECK(hasMoves(state, Inventory{}, 2) == !moves.empty());
+}
@@ -0,0 +1,30 @@
+#include "search.hpp"
+#include "test.hpp"
+#include <algorithm>
+#include <random>
+
+// Runs many short searches while changing the thread count, so helper
+// threads are reused, stopped and restarted; every result must be a legal
+// move from a completed iteration.
+TEST(search_threads) {
+    std::mt19937_64 rng(5);
+    Search search(1);
+    Board board;
+    for (int i = 0; i < 60; ++i) {
+        MoveList moves;
+        board.generateMoves(moves);
+        int winner = 0;
+        if (board.isGameOver(winner)) {
+            board.initialize();
+            continue;
+        }
+        SearchLimits limits;
+        limits.threads = 1 + i / 15;
+        limits.max_depth = 2;
+        limits.move_time = std::chrono::milliseconds(10'000);
+        const SearchResult result = search.run(board, limits);
+        CHECK(result.depth == 2 || std::abs(result.score) >= Search::WIN_SCORE - 64);
+        CHECK(std::find(moves.begin(), moves.end(), result.best_move) != moves.end());
+        board.applyMove(moves[rng() % moves.size()]);
+    }
+}
@@ -0,0 +1,39 @@
+#include "board.hpp"
+#include "test.hpp"
+#include <random>
+
+// Random games, preferring captures half the time so pieces leave the board
+// and slider lines open and close. Every move is applied, checked against a
+// full recomputation, undone, checked again and re-applied.
+TEST(territory_incremental) {
+    std::mt19937_64 rng(99);
+    for (int game = 0; game < 300; ++game) {
+        Board board;
+        board.initialize(1 + game % 2);
+        int winner = 0;
+        while (!board.isGameOver(winner)) {
+            MoveList moves;
+            board.generateMoves(moves);
+            Move move = moves[rng() % moves.size()];
+            if (rng() % 2) {
+                for (const Move& candidate : moves) {
+                    if (candidate.isCapture()) {
+                        move = candidate;
+                        break;
+                    }
+                }
+            }
+
+            const Territory before = board.getTerritory();
+            const int scores[PLAYER_COUNT] = {board.getScore(1), board.getScore(2)};
+            board.applyMove(move);
+            CHECK(board.getTerritory().matchesRecompute(board.getState()));
+            board.undoMove(move);
+            CHECK(board.getTerritory().matchesRecompute(board.getState()));
+            CHECK(board.getTerritory() == before);
+            CHECK(board.getScore(1) == scores[0]);
+            CHECK(board.getScore(2) == scores[1]);
+            board.applyMove(move);
+        }
+    }
+}
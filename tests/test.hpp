@@ -0,0 +1,30 @@
+#ifndef TEST_HPP
+#define TEST_HPP
+
+#include <cstdio>
+#include <vector>
+
+// Minimal self-registering tests. "strategos_tests NAME" runs one test,
+// "strategos_tests" runs them all; the exit code is the number of failed
+// tests.
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& testRegistry();
+void testFailed(const char* file, int line, const char* expression);
+
+#define TEST(name)                                                                              \
+    static void name();                                                                         \
+    [[maybe_unused]] static const bool name##_registered = (testRegistry().push_back({#name, name}), true); \
+    static void name()
+
+#define CHECK(condition)                                   \
+    do {                                                   \
+        if (!(condition)) {                                \
+            testFailed(__FILE__, __LINE__, #condition);    \
+        }                                                  \
+    } while (false)
+
+#endif
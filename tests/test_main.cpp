@@ -0,0 +1,38 @@
+#include "test.hpp"
+#include <cstring>
+
+namespace {
+
+int failures = 0;
+
+} // namespace
+
+std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+void testFailed(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    ++failures;
+}
+
+int main(int argc, char** argv) {
+    int failed = 0;
+    int run = 0;
+    for (const TestCase& test : testRegistry()) {
+        if (argc > 1 && std::strcmp(argv[1], test.name) != 0) {
+            continue;
+        }
+        failures = 0;
+        test.run();
+        ++run;
+        std::printf("%s %s\n", failures ? "FAIL" : "ok  ", test.name);
+        failed += failures != 0;
+    }
+    if (run == 0) {
+        std::fprintf(stderr, "No test named %s\n", argc > 1 ? argv[1] : "");
+        return 1;
+    }
+    return failed;
+}
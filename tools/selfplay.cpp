@@ -0,0 +1,340 @@
+// Batch self-play: plays many games between scripted agents on all cores and
+// writes one CSV row per game, for tuning the rules.
+//
+//   strategos_selfplay --games 100000 --p1 greedy --p2 random --csv games.csv
+//
+// Each worker thread owns an arena for its game state. Boards and move
+// histories are carved from the arena and it is reset between games, so a
+// game between random and greedy agents makes no heap allocations; the
+// search agent still allocates its per-search state on every move. With
+// --record FILE every game is also appended to a binary game record (see
+// game_record.hpp).
+
+#include "board.hpp"
+#include "game_record.hpp"
+#include "search.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum class AgentType {
+    Random,
+    Greedy,
+    Search
+};
+
+struct Options {
+    int games = 1000;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    AgentType agents[PLAYER_COUNT] = {AgentType::Greedy, AgentType::Random};
+    int search_depth = 2;
+    std::uint64_t seed = 1;
+    std::string csv_path = "selfplay.csv";
+    std::string record_path;
+    RuleSet rules;
+    bool help = false;
+};
+
+enum class EndReason : std::uint8_t {
+    KingCaptured,
+    TurnLimit,
+    NoMoves
+};
+
+struct GameResult {
+    int first_player = 1;
+    int winner = 0;
+    int plies = 0;
+    int turns = 0;
+    int scores[PLAYER_COUNT] = {};
+    int captures[PLAYER_COUNT] = {};
+    EndReason reason = EndReason::TurnLimit;
+};
+
+const char* agentName(AgentType agent) {
+    switch (agent) {
+        case AgentType::Random: return "random";
+        case AgentType::Greedy: return "greedy";
+        case AgentType::Search: return "search";
+    }
+    return "?";
+}
+
+std::optional<AgentType> parseAgent(std::string_view name) {
+    for (AgentType agent : {AgentType::Random, AgentType::Greedy, AgentType::Search}) {
+        if (name == agentName(agent)) {
+            return agent;
+        }
+    }
+    return std::nullopt;
+}
+
+const char* reasonName(EndReason reason) {
+    switch (reason) {
+        case EndReason::KingCaptured: return "king";
+        case EndReason::TurnLimit: return "turns";
+        case EndReason::NoMoves: return "stuck";
+    }
+    return "?";
+}
+
+// Per-thread players. The greedy agent takes the move with the best score
+// difference after it, winning moves first; ties are broken at random.
+class Agents {
+public:
+    explicit Agents(const Options& options) : options(options), search(1) {}
+
+    Move choose(AgentType agent, Board& board, const MoveList& moves, std::mt19937_64& rng) {
+        switch (agent) {
+            case AgentType::Random:
+                return moves[rng() % moves.size()];
+            case AgentType::Greedy:
+                return chooseGreedy(board, moves, rng);
+            case AgentType::Search: {
+                SearchLimits limits;
+                limits.threads = 1;
+                limits.max_depth = options.search_depth;
+                limits.move_time = std::chrono::milliseconds(60'000);
+                return search.run(board, limits).best_move;
+            }
+        }
+        return moves[0];
+    }
+
+private:
+    const Options& options;
+    Search search;
+
+    Move chooseGreedy(Board& board, const MoveList& moves, std::mt19937_64& rng) {
+        const int player = board.getPlayerTurn();
+        int best_value = 0;
+        std::size_t best_index = 0;
+        int ties = 0;
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            board.applyMove(moves[i]);
+            int winner = 0;
+            int value = board.getScore(player) - board.getScore(3 - player);
+            if (board.isGameOver(winner) && winner != 0) {
+                value = winner == player ? Search::WIN_SCORE : -Search::WIN_SCORE;
+            }
+            board.undoMove(moves[i]);
+
+            if (i == 0 || value > best_value) {
+                best_value = value;
+                best_index = i;
+                ties = 1;
+            } else if (value == best_value && rng() % ++ties == 0) {
+                best_index = i;  // reservoir sampling among equal moves
+            }
+        }
+        return moves[best_index];
+    }
+};
+
+GameResult playGame(const Options& options, std::uint64_t game_index, Agents& agents,
+                    std::pmr::memory_resource& arena, GameRecordWriter* record, std::uint64_t& moves_played) {
+    std::mt19937_64 rng(options.seed * 0x9E3779B97F4A7C15ULL + game_index);
+    std::pmr::polymorphic_allocator<> allocator(&arena);
+
+    GameResult result;
+    result.first_player = 1 + static_cast<int>(rng() % 2);
+    Board* board = allocator.new_object<Board>();
+    board->initialize(result.first_player, options.rules);
+
+    // Kept for replay and analysis; sized up front so play never reallocates.
+    std::pmr::vector<Move> history(&arena);
+    history.reserve(2 * static_cast<std::size_t>(options.rules.max_turns) + 2);
+
+    MoveList moves;
+    int winner = 0;
+    while (!board->isGameOver(winner)) {
+        moves.clear();
+        board->generateMoves(moves);
+        Move move = agents.choose(options.agents[board->getPlayerTurn() - 1], *board, moves, rng);
+        board->applyMove(move);
+        history.push_back(move);
+    }
+
+    bool king_lost = false;
+    for (int player = 1; player <= PLAYER_COUNT; ++player) {
+        king_lost |= board->getHand(player)[pieceIndex(Piece::King)] == 0
+                  && board->getState().pieces(player, Piece::King).empty();
+    }
+    if (king_lost) {
+        result.reason = EndReason::KingCaptured;
+    } else {
+        result.reason = board->getTurnCount() > options.rules.max_turns ? EndReason::TurnLimit : EndReason::NoMoves;
+    }
+
+    result.winner = winner;
+    result.plies = static_cast<int>(history.size());
+    result.turns = std::min(board->getTurnCount(), options.rules.max_turns);
+    for (int player = 1; player <= PLAYER_COUNT; ++player) {
+        result.scores[player - 1] = board->getScore(player);
+        result.captures[player - 1] = board->getCaptures(player);
+    }
+    if (record) {
+        record->writeGame(result.first_player, winner, history);
+    }
+    moves_played += history.size();
+    allocator.delete_object(board);
+    return result;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            options.help = true;
+            return true;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return false;
+        }
+        ++i;
+        if (arg == "--games") {
+            options.games = std::max(1, std::atoi(value));
+        } else if (arg == "--threads") {
+            options.threads = std::max(1, std::atoi(value));
+        } else if (arg == "--p1" || arg == "--p2") {
+            auto agent = parseAgent(value);
+            if (!agent) {
+                std::fprintf(stderr, "Unknown agent '%s' (random, greedy, search)\n", value);
+                return false;
+            }
+            options.agents[arg == "--p1" ? 0 : 1] = *agent;
+        } else if (arg == "--depth") {
+            options.search_depth = std::max(1, std::atoi(value));
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--csv") {
+            options.csv_path = value;
+        } else if (arg == "--record") {
+            options.record_path = value;
+        } else if (arg == "--stones") {
+            options.rules.stones = std::clamp(std::atoi(value), 0, RuleSet::MAX_STONES);
+        } else if (arg == "--turns") {
+            options.rules.max_turns = std::clamp(std::atoi(value), 1, RuleSet::MAX_TURNS);
+        } else if (arg == "--central-bonus") {
+            options.rules.central_bonus = std::atoi(value);
+        } else if (arg == "--capture-bonus") {
+            options.rules.capture_bonus = std::atoi(value);
+        } else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeCsv(const Options& options, const std::vector<GameResult>& results) {
+    std::FILE* file = std::fopen(options.csv_path.c_str(), "w");
+    if (!file) {
+        std::perror(options.csv_path.c_str());
+        return false;
+    }
+    std::fprintf(file, "game,p1,p2,first,winner,reason,plies,turns,score1,score2,captures1,captures2\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const GameResult& r = results[i];
+        std::fprintf(file, "%zu,%s,%s,%d,%d,%s,%d,%d,%d,%d,%d,%d\n", i, agentName(options.agents[0]),
+                     agentName(options.agents[1]), r.first_player, r.winner, reasonName(r.reason), r.plies,
+                     r.turns, r.scores[0], r.scores[1], r.captures[0], r.captures[1]);
+    }
+    return std::fclose(file) == 0;
+}
+
+void printSummary(const Options& options, const std::vector<GameResult>& results,
+                  std::uint64_t moves, double seconds) {
+    int wins[PLAYER_COUNT + 1] = {};
+    int reasons[3] = {};
+    int first_player_wins = 0;
+    double plies = 0;
+    double scores[PLAYER_COUNT] = {};
+    for (const GameResult& r : results) {
+        ++wins[r.winner];
+        ++reasons[static_cast<int>(r.reason)];
+        first_player_wins += r.winner == r.first_player;
+        plies += r.plies;
+        scores[0] += r.scores[0];
+        scores[1] += r.scores[1];
+    }
+
+    const double games = static_cast<double>(results.size());
+    std::printf("%zu games, %s vs %s, %d threads\n", results.size(), agentName(options.agents[0]),
+                agentName(options.agents[1]), options.threads);
+    std::printf("player 1 wins %.1f%%, player 2 wins %.1f%%, draws %.1f%%, first mover wins %.1f%%\n",
+                100 * wins[1] / games, 100 * wins[2] / games, 100 * wins[0] / games,
+                100 * first_player_wins / games);
+    std::printf("ended by king capture %d, turn limit %d, no moves %d\n", reasons[0], reasons[1], reasons[2]);
+    std::printf("mean length %.1f plies, mean score %.1f - %.1f\n", plies / games, scores[0] / games,
+                scores[1] / games);
+    std::printf("%.3fs: %.0f games/s, %.0f moves/s\n", seconds, games / seconds, moves / seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    const bool parsed = parseOptions(argc, argv, options);
+    if (!parsed || options.help) {
+        std::fprintf(parsed ? stdout : stderr,
+                     "usage: strategos_selfplay [--games N] [--threads N] [--p1 AGENT] [--p2 AGENT]\n"
+                     "       [--depth N] [--seed N] [--csv FILE] [--record FILE] [--stones N] [--turns N]\n"
+                     "       [--central-bonus N] [--capture-bonus N]\n"
+                     "Agents are random, greedy and search.\n");
+        return parsed ? 0 : 1;
+    }
+
+    GameRecordWriter record;
+    if (!options.record_path.empty() && !record.open(options.record_path, options.rules)) {
+        std::fprintf(stderr, "Cannot append to %s (unwritable, recorded with other rules, or bonuses "
+                             "outside -128..127)\n",
+                     options.record_path.c_str());
+        return 1;
+    }
+    GameRecordWriter* record_out = record.isOpen() ? &record : nullptr;
+
+    std::vector<GameResult> results(options.games);
+    std::atomic<int> next_game{0};
+    std::atomic<std::uint64_t> total_moves{0};
+
+    auto worker = [&]() {
+        // Enough for a Board and a move history; reused for every game.
+        constexpr std::size_t ARENA_BYTES = 64 * 1024;
+        auto buffer = std::make_unique<std::byte[]>(ARENA_BYTES);
+        std::pmr::monotonic_buffer_resource arena(buffer.get(), ARENA_BYTES, std::pmr::null_memory_resource());
+        Agents agents(options);
+        std::uint64_t moves = 0;
+        for (int game; (game = next_game.fetch_add(1, std::memory_order_relaxed)) < options.games;) {
+            results[game] = playGame(options, static_cast<std::uint64_t>(game), agents, arena, record_out, moves);
+            arena.release();
+        }
+        total_moves.fetch_add(moves, std::memory_order_relaxed);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> pool;
+        for (int i = 0; i < options.threads; ++i) {
+            pool.emplace_back(worker);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    printSummary(options, results, total_moves.load(), elapsed.count());
+    return writeCsv(options, results) ? 0 : 1;
+}